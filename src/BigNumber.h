@@ -3,7 +3,8 @@
 	@breif	: Implementing BigNumber(no limit in number of digits) numbers
 	@date	: 03-March-2017
 
-	@NOTE	: Currently only supports, Integers
+	@NOTE	: Magnitude is kept as binary limbs together with the count of fraction digits,
+			  decimal text is only produced in parse, asString and to_chars.
 
 	@Assumption : No operation will reach the limit of number of digit crossing the size of __int64
 */
@@ -17,66 +18,133 @@
 #include <string>
 #include <cassert>
 #include <cmath>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
 #include <sstream>
 #include <iomanip>
+#include <charconv>
+#include <string_view>
+#include <array>
+#include <mutex>
 #include "helper.h"
+#include "limbArithmetic.h"
+#include "limbMultiply.h"
+#include "limbDivide.h"
+#include "radixConversion.h"
+#include "limbModular.h"
+#include "limbRoot.h"
+#include "limbSeries.h"
 
 namespace nsNumber
 {
+class ModContext;
+class BigNumberView;
+class DigitParser;
+
 // storing number in reverse
-// at 0 index we will have right most value
+// at 0 index we will have right most limb
+// value = m_limbs / 10^m_scale, a negative scale holds the trailing zeros of an integer
 class BigNumber
 {
 	using ValueType		= std::string;
 	using SizeType		= size_t;
+	using ScaleType		= int64_t;
 	using CharType		= std::string::value_type;
+	using Limb			= nsLimb::Limb;
+	using LimbVector	= nsLimb::LimbVector;
+	using DoubleLimb	= nsLimb::DoubleLimb;
 public:
+	// How divmod rounds the quotient, the remainder takes the matching sign
+	enum class DivisionMode : uint8_t
+	{
+		kTRUNCATE,		// towards zero, the remainder has the sign of the dividend
+		kFLOOR,			// towards negative infinity, the remainder has the sign of the divisor
+		kEUCLIDEAN		// the remainder is never negative
+	};
+
+	// How to_chars writes a value, from_chars only looks at the group separator
+	struct FormatOptions
+	{
+		enum class Sign : uint8_t
+		{
+			kNEGATIVE,		// '-' on negative values only
+			kALWAYS,		// '+' on the others
+			kSPACE			// ' ' on the others
+		};
+
+		enum class Notation : uint8_t
+		{
+			kFIXED,			// 1234.5
+			kSCIENTIFIC		// 1.2345e+03
+		};
+
+		// Every digit the value holds
+		static constexpr SizeType kEXACT = SIZE_MAX;
+
+		Sign		sign{ Sign::kNEGATIVE };
+		Notation	notation{ Notation::kFIXED };
+		SizeType	precision{ kEXACT };	// digits after the point, rounded half to even
+		char		groupSeparator{};		// between every groupSize integer digits, none when 0
+		SizeType	groupSize{ 3 };
+	};
+
 	BigNumber() = default;
 	~BigNumber() { clear(); }
 
 	template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool> = true>
-	explicit BigNumber(const Number number) { parse(std::to_string(number)); }
+	explicit BigNumber(const Number number) { assignNative(number); }
 
 	explicit BigNumber(const ValueType& num, const ValueType& frac, bool isNegative) { parse((isNegative ? "-" : "") + num + "." + frac); }
 	explicit BigNumber(const ValueType& dataString) { parse(dataString); }
-	
+
 	// Copy and Move
 	BigNumber(const BigNumber& other) { copyFrom(other); }
 	BigNumber& operator=(const BigNumber& other) { copyFrom(other); return *this; }
 
 	template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool> = true>
-	BigNumber& operator=(const Number number) { parse(std::to_string(number)); return *this; }
+	BigNumber& operator=(const Number number) { assignNative(number); return *this; }
 
 	BigNumber(BigNumber&& other) noexcept { moveFrom(std::move(other)); }
 	BigNumber& operator=(BigNumber&& other) noexcept { moveFrom(std::move(other)); return *this; }
-	
-	inline bool empty() const { return m_szFraction.empty() && m_szNumber.empty(); }
 
-	inline SizeType size() const { return (m_bNegative ? 1 : 0) + m_szNumber.size() + m_szFraction.size(); }
-	inline void clear() { m_szNumber.clear(); m_szFraction.clear(); m_bNegative = false; }
+	inline bool empty() const { return m_state == State::kEMPTY; }
+
+	inline SizeType size() const;
+	inline void clear() { m_limbs.clear(); m_scale = 0; m_bNegative = false; m_state = State::kEMPTY; }
 
 	inline bool isNegative() const { return m_bNegative; };
-	inline bool isInteger() const { return m_szFraction.empty(); };
-	inline bool isFloatingPoint() const { return !m_szFraction.empty(); };
+	inline bool isInteger() const { return m_scale <= 0; };
+	inline bool isFloatingPoint() const { return m_scale > 0; };
 
-	inline void makeFloatingPoint() { m_szFraction.empty() ? m_szFraction.push_back('0') : void(); }
+	inline void makeFloatingPoint() { m_scale <= 0 ? (nsLimb::multiplyByPow10(m_limbs, static_cast<SizeType>(1 - m_scale)), void(m_scale = 1)) : void(); }
 
-	inline bool isEven() const { return m_szFraction.empty() ? isEven(m_szNumber) : isEven(m_szFraction, true); }
+	inline bool isEven() const { return m_state == State::kFINITE && (m_limbs.empty() || m_scale < 0 || (m_limbs[0] & 1) == 0); }
 	inline bool isOdd() const { return !isEven(); }
 
+	// Integers only, false for anything else. Negative values are powers of odd exponents only.
+	inline bool isPerfectSquare() const;
+	inline bool isPerfectPower() const;
+
+	// Constants rounded to precision digits, computed once per precision and cached
+	static inline BigNumber pi(const SizeType precision = kPRECISION) { return constant(Constant::kPI, precision); }
+	static inline BigNumber e(const SizeType precision = kPRECISION) { return constant(Constant::kE, precision); }
+	static inline BigNumber ln2(const SizeType precision = kPRECISION) { return constant(Constant::kLN2, precision); }
+	static inline BigNumber sqrt2(const SizeType precision = kPRECISION) { return constant(Constant::kSQRT2, precision); }
+
 	inline void setMaxPrecision(SizeType val) { m_precision = val; }
 	inline SizeType getMaxPrecision() const { return m_precision; }
-	
-	ValueType significand() const { return (m_bNegative ? "-" : "") + m_szNumber; }
-	ValueType fraction() const { return m_szFraction; }
 
-	explicit inline operator ValueType() const { return asString(true, true); }
+	ValueType significand() const { const ValueType str = asString(false, false); return (m_bNegative ? "-" : "") + str.substr(0, str.size() - fractionDigits()); }
+	ValueType fraction() const { const ValueType str = asString(false, false); return str.substr(str.size() - fractionDigits()); }
+
+	explicit inline operator ValueType() const { return formatString(FormatOptions()); }
 
 	// Member overload operators
 	// Conversion operator
 	template <typename Floating, std::enable_if_t<std::is_floating_point<Floating>::value, bool> = true>
 	explicit inline operator Floating() const { Floating val{}; asFloatingPoint(val); return val; }
-	
+
 	template <typename Integer, std::enable_if_t<std::is_integral<Integer>::value, bool> = true>
 	explicit inline operator Integer() const { Integer val{}; asInteger(val); return val; }
 
@@ -93,31 +161,31 @@ public:
 	inline bool operator<(const Number& num) const { return isLessThan(num); }
 
 	template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool> = true>
-	inline bool operator>(const Number& num) const { return !(isLessThan(num)); }
+	inline bool operator>(const Number& num) const { return !(isLessThan(num) || isEqual(num)); }
 
 	template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool> = true>
 	inline bool operator<=(const Number& num) const { return (isLessThan(num) || isEqual(num)); }
 
 	template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool> = true>
-	inline bool operator>=(const Number& num) const { return (!isLessThan(num) || isEqual(num)); }
+	inline bool operator>=(const Number& num) const { return !(isLessThan(num)); }
 
 	// Member Overloaded operators Arithmetic operators for Integeral and Floating point numbers
 	template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool> = true>
-	inline BigNumber& operator+=(const Number& num) { (*this) = add(BigNumber(num)); return *this; }
+	inline BigNumber& operator+=(const Number& num) { addNative(num, false); return *this; }
 
 	template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool> = true>
-	inline BigNumber& operator-=(const Number& num) { (*this) = add(BigNumber(-num)); return *this; }
+	inline BigNumber& operator-=(const Number& num) { addNative(num, true); return *this; }
 
 	template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool> = true>
-	inline BigNumber& operator*=(const Number& num) { (*this) = multiply(BigNumber(num)); return *this; }
+	inline BigNumber& operator*=(const Number& num) { multiplyNative(num); return *this; }
 
 	template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool> = true>
-	inline BigNumber& operator/=(const Number& num) { (*this) = divide(BigNumber(num)); return *this; }
+	inline BigNumber& operator/=(const Number& num) { divideNative(num); return *this; }
 
 	template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool> = true>
-	inline BigNumber& operator%=(const Number& num) { (*this) = modulo(BigNumber(num)); return *this; }
+	inline BigNumber& operator%=(const Number& num) { moduloNative(num); return *this; }
+
 
-	
 	inline BigNumber& operator+=(const BigNumber& other) { (*this) = add(other); return *this; }
 	inline BigNumber& operator-=(const BigNumber& other) { (*this) = add(-other); return *this; }
 	inline BigNumber& operator*=(const BigNumber& other) { (*this) = multiply(other); return *this; }
@@ -135,9 +203,9 @@ public:
 	inline bool operator<(const BigNumber& other) const { return isLessThan(other); };
 	inline bool operator==(const BigNumber& other) const { return isEqual(other); }
 	inline bool operator!=(const BigNumber& other) const { return !(isEqual(other)); }
-	inline bool operator>(const BigNumber& other) const { return !(isLessThan(other)); }
+	inline bool operator>(const BigNumber& other) const { return other.isLessThan(*this); }
 	inline bool operator<=(const BigNumber& other) const { return (isLessThan(other) || isEqual(other)); }
-	inline bool operator>=(const BigNumber& other) const { return (!isLessThan(other) || isEqual(other)); }
+	inline bool operator>=(const BigNumber& other) const { return (other.isLessThan(*this) || isEqual(other)); }
 
 	// Friend Overloaded operators
 	friend inline BigNumber operator+(const BigNumber& lhs, const BigNumber& rhs) { return lhs.add(rhs); }
@@ -147,28 +215,28 @@ public:
 	friend inline BigNumber operator%(const BigNumber& lhs, const BigNumber& rhs) { return lhs.modulo(rhs); }
 
 	template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool> = true>
-	friend inline BigNumber operator+(const BigNumber& lhs, const Number& num) { return lhs.add(BigNumber(num)); }
+	friend inline BigNumber operator+(const BigNumber& lhs, const Number& num) { BigNumber result(lhs); result.addNative(num, false); return result; }
 
 	template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool> = true>
-	friend inline BigNumber operator-(const BigNumber& lhs, const Number& num) { return lhs.add(BigNumber(-num)); }
+	friend inline BigNumber operator-(const BigNumber& lhs, const Number& num) { BigNumber result(lhs); result.addNative(num, true); return result; }
 
 	template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool> = true>
-	friend inline BigNumber operator*(const BigNumber& lhs, const Number& num) { return lhs.multiply(BigNumber(num)); }
+	friend inline BigNumber operator*(const BigNumber& lhs, const Number& num) { BigNumber result(lhs); result.multiplyNative(num); return result; }
 
 	template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool> = true>
-	friend inline BigNumber operator/(const BigNumber& lhs, const Number& num) { return lhs.divide(BigNumber(num)); }
+	friend inline BigNumber operator/(const BigNumber& lhs, const Number& num) { BigNumber result(lhs); result.divideNative(num); return result; }
 
 	template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool> = true>
-	friend inline BigNumber operator%(const BigNumber& lhs, const Number& num) { return lhs.modulo(BigNumber(num)); }
+	friend inline BigNumber operator%(const BigNumber& lhs, const Number& num) { BigNumber result(lhs); result.moduloNative(num); return result; }
 
 	template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool> = true>
-	friend inline BigNumber operator+(const Number& num, const BigNumber& rhs) { return rhs.add(BigNumber(num)); }
+	friend inline BigNumber operator+(const Number& num, const BigNumber& rhs) { BigNumber result(rhs); result.addNative(num, false); return result; }
 
 	template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool> = true>
 	friend inline BigNumber operator-(const Number& num, const BigNumber& rhs) { return BigNumber(num).add(-rhs); }
 
 	template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool> = true>
-	friend inline BigNumber operator*(const Number& num, const BigNumber& rhs) { return rhs.multiply(BigNumber(num)); }
+	friend inline BigNumber operator*(const Number& num, const BigNumber& rhs) { BigNumber result(rhs); result.multiplyNative(num); return result; }
 
 	template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool> = true>
 	friend inline BigNumber operator/(const Number& num, const BigNumber& rhs) { return BigNumber(num).divide(rhs); }
@@ -185,20 +253,81 @@ public:
 	template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool> = true>
 	friend inline BigNumber pow(const Number& num, const BigNumber& rhs) { return BigNumber(num).power(rhs); }
 
-	friend inline std::ostream& operator<< (std::ostream& out, const BigNumber& obj) { out << (ValueType)obj << '\n'; return out; }
+	// base^exp mod modulus without forming base^exp, integers only with exp >= 0 and modulus > 0, result in [0, modulus)
+	friend inline BigNumber powmod(const BigNumber& base, const BigNumber& exp, const BigNumber& modulus) { return base.powerModulo(exp, modulus); }
+
+	// Roots rounded to the precision of x, even roots of negative values are NAN
+	friend inline BigNumber sqrt(const BigNumber& x) { return x.nthRoot(2); }
+	friend inline BigNumber cbrt(const BigNumber& x) { return x.nthRoot(3); }
+	friend inline BigNumber root(const BigNumber& x, const uint64_t n) { return x.nthRoot(n); }
+
+	// e^x, natural and base 10 logarithm rounded to the precision of x, logarithms of values <= 0 are NAN
+	friend inline BigNumber exp(const BigNumber& x) { return x.exponential(); }
+	friend inline BigNumber log(const BigNumber& x) { return x.logarithm(); }
+	friend inline BigNumber log10(const BigNumber& x) { return x.logarithm10(); }
+
+	// floor(sqrt(n)) and n - floor(sqrt(n))^2 for a non negative integer n
+	friend inline BigNumber isqrt(const BigNumber& n) { return n.integerSquareRoot().first; }
+	friend inline std::pair<BigNumber, BigNumber> isqrt_rem(const BigNumber& n) { return n.integerSquareRoot(); }
+	friend inline bool is_perfect_square(const BigNumber& n) { return n.isPerfectSquare(); }
+	friend inline bool is_perfect_power(const BigNumber& n) { return n.isPerfectPower(); }
+
+	// Integer quotient and remainder from one division, lhs = quotient * rhs + remainder
+	friend inline std::pair<BigNumber, BigNumber> divmod(const BigNumber& lhs, const BigNumber& rhs, const DivisionMode mode = DivisionMode::kTRUNCATE) { return lhs.divideWithRemainder(rhs, mode); }
+
+	friend inline std::ostream& operator<< (std::ostream& out, const BigNumber& obj) { obj.writeTo(out); return out; }
+
+	// Writes value into [first, last), nothing goes on the heap below nsLimb::kTO_DECIMAL_THRESHOLD limbs.
+	// A buffer too small gives { last, std::errc::value_too_large }, size_hint is the exact size needed.
+	friend inline std::to_chars_result to_chars(char* first, char* last, const BigNumber& value) { return value.formatChars(first, last, FormatOptions()); }
+	friend inline std::to_chars_result to_chars(char* first, char* last, const BigNumber& value, const FormatOptions& options) { return value.formatChars(first, last, options); }
+	friend inline SizeType size_hint(const BigNumber& value) { return value.formattedSize(FormatOptions()); }
+	friend inline SizeType size_hint(const BigNumber& value, const FormatOptions& options) { return value.formattedSize(options); }
+
+	// Reads the longest number at first, a sign ('+' too), digits with an optional point and exponent, NAN or INFINITY.
+	// No whitespace is skipped. Digits past the precision of value are rounded half to even into its own limbs,
+	// value is left as it was on an error.
+	friend inline std::from_chars_result from_chars(const char* first, const char* last, BigNumber& value) { return value.parseChars(first, last, '\0'); }
+	friend inline std::from_chars_result from_chars(const char* first, const char* last, BigNumber& value, const FormatOptions& options) { return value.parseChars(first, last, options.groupSeparator); }
 
 public:
 	inline int to_int(const CharType ch) const { return ch - '0'; }
 	inline CharType to_char(const int digit) const { return char(digit + '0'); }
-	inline void flipSign() { m_bNegative = !m_bNegative; }
+	inline void flipSign() { m_bNegative = isZero() ? false : !m_bNegative; }
 
-	inline long long stoll_s(const ValueType& str) const { return (str.find_first_not_of("0.") == ValueType::npos) ? 0 : std::stoll(str); }
-	inline long double stold_s(const ValueType& str) const { return (str.find_first_not_of("0.") == ValueType::npos) ? 0 : std::stold(str); }
+	inline bool isZero() const { return m_state == State::kFINITE && m_limbs.empty(); }
+	inline bool isFinite() const { return m_state == State::kFINITE; }
+	inline SizeType fractionDigits() const { return m_scale > 0 ? static_cast<SizeType>(m_scale) : 0; }
 
-	inline bool isLessThan(const BigNumber& other) const { return compareStringAsNumber(m_szNumber, other.m_szNumber); }
+	inline bool isLessThan(const BigNumber& other) const;
 
 	inline ValueType asString(const bool withSign, const bool combineWithDecimal) const;
 
+	// Digits of a value to format, rounded as the options ask. Small values keep them on the stack.
+	struct FormattedDigits
+	{
+		char			m_stack[nsLimb::decimalDigitBound(nsLimb::kTO_DECIMAL_THRESHOLD) + 1];
+		ValueType		m_heap;
+		const char*		m_text{};		// NAN or INFINITY instead of digits
+		char*			m_digits{};		// without leading zeros, none for zero
+		SizeType		m_count{};
+		ScaleType		m_exponent{};	// fixed, value = digits / 10^exponent; scientific, value = d.ddd * 10^exponent
+		SizeType		m_fraction{};	// digits after the point
+		char			m_sign{};
+	};
+
+	inline void formatDigits(FormattedDigits& digits, const FormatOptions& options) const;
+	static inline bool roundDigits(FormattedDigits& digits, const ScaleType keep);
+	static inline SizeType formattedSize(const FormattedDigits& digits, const FormatOptions& options);
+	static inline char* writeFormatted(char* out, const FormattedDigits& digits, const FormatOptions& options);
+	inline SizeType formattedSize(const FormatOptions& options) const;
+	inline std::to_chars_result formatChars(char* first, char* last, const FormatOptions& options) const;
+	inline ValueType formatString(const FormatOptions& options) const;
+	inline void writeTo(std::ostream& out) const;
+	inline std::from_chars_result parseChars(const char* first, const char* last, const char groupSeparator);
+
+	inline int compare(const BigNumber& other) const;
+	inline int compareMagnitude(const BigNumber& other) const;
 	inline bool isEqual(const BigNumber& other) const;
 
 	template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool> = true>
@@ -223,25 +352,55 @@ public:
 	inline BigNumber multiply(const BigNumber& other) const;
 	inline BigNumber divide(const BigNumber& other) const;
 	inline BigNumber modulo(const BigNumber& other) const;
+	inline std::pair<BigNumber, BigNumber> divideWithRemainder(const BigNumber& other, const DivisionMode mode) const;
 	inline BigNumber power(const BigNumber &exp) const;
+	inline BigNumber powerModulo(const BigNumber &exp, const BigNumber &modulus) const;
+	inline BigNumber square() const;
+	inline BigNumber nthRoot(const uint64_t n) const;
+	inline BigNumber exponential() const;
+	inline BigNumber logarithm() const;
+	inline BigNumber logarithm10() const;
+	inline std::pair<BigNumber, BigNumber> integerSquareRoot() const;
 
-	inline ValueType addHelper(const ValueType &in1, const ValueType &in2) const;
-	inline ValueType subHelper(const ValueType &in1, const ValueType &in2) const;
+	// Kernels against a primitive operand, no temporary BigNumber or string for integers
+	template <typename Number>
+	inline void assignNative(const Number number);
 
-	inline ValueType addHelper(ValueType in1, ValueType in2, int &carry, const bool isFractionPart = false) const;
-	inline ValueType subHelper(ValueType in1, ValueType in2, int &borrow, const bool isFractionPart = false) const;
+	template <typename Number>
+	inline void addNative(const Number number, const bool subtract);
 
-	inline ValueType multiplyHelper(ValueType in1, ValueType in2) const;
+	template <typename Number>
+	inline void multiplyNative(const Number number);
 
-	inline ValueType longMultiplication(ValueType in1, ValueType in2) const;
-	inline ValueType karatsubaMultiplication(const ValueType &in1, const ValueType &in2) const;
+	template <typename Number>
+	inline void divideNative(const Number number);
 
-	inline ValueType divideAsIntegers(ValueType numerator, ValueType denominator, ValueType&remainder) const;
-	inline ValueType divideAsFloatingPoint(const ValueType&num1, const ValueType& frac1, const ValueType& num2, const ValueType& frac2) const;
+	template <typename Number>
+	inline void moduloNative(const Number number);
 
-	inline ValueType powerHelperIntegerExponent(const ValueType&base, const ValueType&exp) const;
+	inline void addInteger(const uint64_t magnitude, const bool negative);
+	inline void multiplyInteger(const uint64_t magnitude, const bool negative);
+	inline void divideInteger(const uint64_t magnitude, const bool negative);
+	inline void moduloInteger(const uint64_t magnitude, const bool negative);
+	inline int compareInteger(const uint64_t magnitude, const bool negative) const;
 
-	inline ValueType nth_Root(const ValueType &num, const ValueType &fraction) const;
+	inline LimbVector addHelper(const LimbVector &in1, const LimbVector &in2) const;
+	inline LimbVector subHelper(const LimbVector &in1, const LimbVector &in2) const;
+
+	inline LimbVector multiplyHelper(const LimbVector &in1, const LimbVector &in2) const;
+	inline LimbVector squareHelper(const LimbVector &in) const;
+	inline bool roundedShortProduct(const LimbVector &in1, const LimbVector &in2);
+
+	inline LimbVector divideAsIntegers(const LimbVector &numerator, const LimbVector &denominator, LimbVector &remainder) const;
+	inline BigNumber divideAsFloatingPoint(const BigNumber& numerator, const BigNumber& denominator) const;
+
+	inline BigNumber powerHelperIntegerExponent(const BigNumber &base, const LimbVector &exp) const;
+	inline BigNumber powerHelperFractionalExponent(const BigNumber &exp) const;
+
+	static inline BigNumber exponentialSeries(const LimbVector& u, const SizeType digits, const SizeType precision);
+	static inline BigNumber logarithmNewton(const BigNumber& a, const SizeType precision);
+	static inline BigNumber inverseArctanh(const Limb x, const SizeType precision);
+	inline double log10Estimate() const;
 
 	inline void multiplyBy10(uint64_t times = 1);
 	inline void divideBy10(uint64_t times = 1);
@@ -249,1386 +408,2230 @@ public:
 	inline void increment();
 	inline void decrement();
 
-	inline void increment(ValueType &str) const;
-	inline void decrement(ValueType &str) const;
+	inline LimbVector scaledMagnitude(const ScaleType scale) const;
+	inline bool nativeMagnitude(const ScaleType scale, DoubleLimb& val) const;
+	inline void trimZeros();
 
-	inline bool isEven(const ValueType& str, const bool isFractionPart = false) const;
+	inline void roundOff(const SizeType precision);
+	inline int rounder(const LimbVector& quotient, const LimbVector& remainder, const LimbVector& divisor) const;
 
-	inline void split_at(const ValueType str, const SizeType digitCountInLow, ValueType& high, ValueType& low) const;
-	inline std::pair<ValueType, ValueType> split_at(const ValueType& str, const CharType delimeter = '.') const;
-	inline void makeEqualLength(ValueType& str1, ValueType& str2, const bool isFractionPart = false) const;
-	inline void trimZeros(ValueType& str, const bool isFractionPart = false) const;
-	inline int compareStringAsNumber(const ValueType& str1, const ValueType& str2, const bool isFractionPart) const;
-	inline int compareStringAsNumber(const ValueType& str1, const ValueType& str2) const;
-	inline int fillUpDstForDivision(ValueType &dst, ValueType &numerator, const ValueType &denominator) const;
-
-	inline void roundOff(ValueType& num, ValueType& frac, const SizeType precision) const;
-	inline void roundOff(ValueType& number, const SizeType precision) const;
-
-	inline int rounder(ValueType& str, const SizeType pos, const SizeType precision) const;
-	
 private:
-	static const int kBLOCK_SIZE;
+	friend class ModContext;
+	friend class BigNumberView;
+	friend class DigitParser;
+	friend inline size_t serializedSize(const BigNumber& value);
+	friend inline size_t serialize(const BigNumber& value, void* buffer, const size_t capacity);
+
+	enum class State : uint8_t
+	{
+		kEMPTY,
+		kFINITE,
+		kNAN,
+		kINFINITY
+	};
+
+	enum class Constant : uint8_t
+	{
+		kPI,
+		kE,
+		kLN2,
+		kLN10,
+		kSQRT2,
+		kCOUNT
+	};
+
 	static const SizeType kPRECISION;
+	// Extra digits carried by exp and log so that the rounded result is right
+	static const SizeType kGUARD_DIGITS;
+	// Results of exp and pow with more digits before the point are out of range
+	static const double kMAX_RESULT_DIGITS;
+
+	template <typename Number>
+	static inline bool isNegativeNative(const Number number);
+
+	template <typename Number>
+	static inline uint64_t magnitudeOf(const Number number);
+
+	static inline BigNumber fromInteger(const uint64_t magnitude, const bool negative);
+
+	static inline BigNumber constant(const Constant id, const SizeType precision);
+	static inline BigNumber computeConstant(const Constant id, const SizeType precision);
 private:
 	bool					m_bNegative{false};
-	ValueType				m_szNumber{"0"};
-	ValueType				m_szFraction;
+	State					m_state{ State::kFINITE };
+	LimbVector				m_limbs;
+	ScaleType				m_scale{};
 	SizeType				m_precision{ kPRECISION };
 };
 
 const BigNumber::SizeType BigNumber::kPRECISION = 6;
-const int BigNumber::kBLOCK_SIZE = 12;
+const BigNumber::SizeType BigNumber::kGUARD_DIGITS = 10;
+const double BigNumber::kMAX_RESULT_DIGITS = 1e15;
 
 static const BigNumber sNAN("NAN");
 static const BigNumber& sDIVIDE_BY_ZERO(sNAN);
 static const BigNumber sINFINITY("INFINITY");
 
 // Private Methods
-BigNumber::ValueType BigNumber::asString(const bool withSign, const bool combineWithDecimal) const
+BigNumber::SizeType BigNumber::size() const
 {
-	ValueType szRet = m_szNumber.empty() ? "0" : m_szNumber;
-	if (withSign && m_bNegative)
+	if (m_state != State::kFINITE)
 	{
-		szRet.insert(0, 1, '-');
+		return asString(true, true).size();
 	}
-	if (!m_szFraction.empty())
+	const SizeType digits = nsLimb::decimalDigitCount(m_limbs);
+	if (m_scale <= 0)
 	{
-		if (combineWithDecimal)
-		{
-			szRet.insert(szRet.size(), 1, '.');
-		}
-		szRet.insert(szRet.size(), m_szFraction);
+		return (m_bNegative ? 1 : 0) + digits + (m_limbs.empty() ? 0 : static_cast<SizeType>(-m_scale));
 	}
-	return szRet;
-}
-
-bool BigNumber::isEqual(const BigNumber& other) const
-{
-	return m_szNumber == other.m_szNumber && m_szFraction == other.m_szFraction && m_bNegative == other.m_bNegative;
+	const SizeType scale = static_cast<SizeType>(m_scale);
+	const SizeType intDigits = digits > scale ? digits - scale : 1;
+	return (m_bNegative ? 1 : 0) + intDigits + scale;
 }
 
-template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool>>
-bool BigNumber::isLessThan(const Number other) const
+bool BigNumber::isLessThan(const BigNumber& other) const
 {
-	Number val{};
-	if (std::is_integral<Number>::value)
+	if (m_state == State::kNAN || other.m_state == State::kNAN || empty() || other.empty())
 	{
-		return asInteger(val) && val < other;
+		return false;
 	}
-	return asFloatingPoint(val) && val < other;
-}
-
-template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool>>
-bool BigNumber::isEqual(const Number other) const
-{
-	Number val{};
-	if (std::is_integral<Number>::value)
+	if (m_state == State::kINFINITY || other.m_state == State::kINFINITY)
 	{
-		return isInteger() && asInteger(val) && val == other;
+		const int lhs = m_state == State::kINFINITY ? (m_bNegative ? -1 : 1) : 0;
+		const int rhs = other.m_state == State::kINFINITY ? (other.m_bNegative ? -1 : 1) : 0;
+		return lhs < rhs;
 	}
-	return asFloatingPoint(val) && val == other;
+	return compare(other) < 0;
 }
 
-template <typename T>
-bool BigNumber::asInteger(T& val, const ValueType &str, const bool quiet) const
+BigNumber::ValueType BigNumber::asString(const bool withSign, const bool combineWithDecimal) const
 {
-	val = static_cast<T>(0);
-	try
+	if (m_state == State::kNAN)
 	{
-		val = str.empty() ? static_cast<T>(stoll_s(significand())) : static_cast<T>(stoll_s(str));
+		return "NAN";
 	}
-	catch (std::exception& e)
+	if (m_state == State::kINFINITY)
 	{
-		if (!quiet)
+		return (withSign && m_bNegative ? "-" : "") + ValueType("INFINITY");
+	}
+	ValueType szRet = nsLimb::toDecimal(m_limbs);
+	const SizeType scale = fractionDigits();
+	if (scale > 0)
+	{
+		if (szRet.size() <= scale)
 		{
-			LOG_ERROR("Exception : " + ValueType(e.what()));
+			szRet.insert(0, scale - szRet.size() + 1, '0');
+		}
+		if (combineWithDecimal)
+		{
+			szRet.insert(szRet.size() - scale, 1, '.');
 		}
-		return false;
 	}
-	return true;
-}
-
-template <typename T>
-bool BigNumber::asFloatingPoint(T& val, const ValueType &str, const bool quiet) const
-{
-	val = static_cast<T>( 0.0 );
-	try
+	else if (m_scale < 0 && !m_limbs.empty())
 	{
-		val = str.empty() ? static_cast<T>(stold_s(static_cast<ValueType>(*this))) : static_cast<T>(stold_s(str));
+		// The zeros held in the scale only show up here
+		szRet.append(static_cast<SizeType>(-m_scale), '0');
 	}
-	catch (std::exception& e)
+	if (withSign && m_bNegative)
 	{
-		if (!quiet)
-		{
-			LOG_ERROR("Exception : " + ValueType(e.what()));
-		}
-		return false;
+		szRet.insert(0, 1, '-');
 	}
-	return true;
+	return szRet;
 }
 
-void BigNumber::copyFrom(const BigNumber& other)
+void BigNumber::formatDigits(FormattedDigits& digits, const FormatOptions& options) const
 {
-	if (this != &other)
+	if (m_state == State::kNAN)
 	{
-		m_szNumber = other.m_szNumber;
-		m_bNegative = other.m_bNegative;
-		m_szFraction = other.m_szFraction;
+		digits.m_text = "NAN";
+		return;
 	}
-}
-
-void BigNumber::moveFrom(BigNumber&& other)
-{
-	assert(this != &other);
-	m_szNumber = std::exchange(other.m_szNumber, ValueType());
-	m_szFraction = std::exchange(other.m_szFraction, ValueType());
-	m_bNegative = std::exchange(other.m_bNegative, false);
-}
-
-bool BigNumber::isValid(const ValueType& str, SizeType& posOfDecimalPoint) const
-{
-	if (str.empty())
+	const bool scientific = options.notation == FormatOptions::Notation::kSCIENTIFIC;
+	if (m_state == State::kINFINITY)
 	{
-		return false;
+		digits.m_text = "INFINITY";
 	}
-	posOfDecimalPoint = 0;
-	SizeType i = (str[0] == '-' ? 1 : 0);
-	bool decimalPoint = false;
-	while (i < str.size())
+	else
 	{
-		if (str[i] == '.')
+		// One character in front of the digits for a carry out of rounding
+		const SizeType bound = nsLimb::decimalDigitBound(m_limbs.size()) + 1;
+		char* buffer = digits.m_stack;
+		if (bound > sizeof(digits.m_stack))
 		{
-			if (decimalPoint)
+			digits.m_heap.resize(bound);
+			buffer = &digits.m_heap[0];
+		}
+		digits.m_count = nsLimb::toDecimalBackward(m_limbs.data(), m_limbs.size(), buffer + bound);
+		digits.m_digits = buffer + bound - digits.m_count;
+		digits.m_exponent = m_scale;
+
+		if (scientific)
+		{
+			const ScaleType exponent = static_cast<ScaleType>(digits.m_count) - 1 - m_scale;
+			digits.m_exponent = digits.m_count > 0 ? exponent : 0;
+			SizeType precision = options.precision;
+			if (precision == FormatOptions::kEXACT)
 			{
-				return false;
+				while (digits.m_count > 1 && digits.m_digits[digits.m_count - 1] == '0')
+				{
+					digits.m_count--;
+				}
+				precision = digits.m_count > 0 ? digits.m_count - 1 : 0;
 			}
-			decimalPoint = true;
-			posOfDecimalPoint = i;
+			if (digits.m_count > precision + 1 && roundDigits(digits, static_cast<ScaleType>(precision + 1)))
+			{
+				// 9.99 up to 10.0, the extra digit is a zero
+				digits.m_count--;
+				digits.m_exponent++;
+			}
+			digits.m_fraction = precision;
 		}
-		else if (!std::isdigit(str[i]))
+		else if (options.precision == FormatOptions::kEXACT)
 		{
-			return false;
+			digits.m_fraction = fractionDigits();
+		}
+		else
+		{
+			const ScaleType precision = static_cast<ScaleType>(std::min<SizeType>(options.precision, static_cast<SizeType>(INT64_MAX)));
+			if (m_scale > precision)
+			{
+				// Digits past the precision make up m_scale - precision of the count
+				const SizeType dropped = static_cast<SizeType>(m_scale - precision);
+				const ScaleType keep = dropped >= digits.m_count ? (dropped == digits.m_count ? 0 : -1) : static_cast<ScaleType>(digits.m_count - dropped);
+				roundDigits(digits, keep);
+				digits.m_exponent = precision;
+			}
+			digits.m_fraction = options.precision;
 		}
-		i++;
 	}
-	return true;
-}
 
-void BigNumber::parse(const ValueType& str)
-{
-	clear();
-
-	static int count = 0;
-	if (count < 3 && (str == "NAN" || str == "INFINITY"))
+	// Rounded to zero has no sign, as zero itself
+	if (m_bNegative && (digits.m_text != nullptr || digits.m_count > 0))
 	{
-		count++;
-		m_szNumber = str;
-		return;
+		digits.m_sign = '-';
+	}
+	else if (options.sign == FormatOptions::Sign::kALWAYS)
+	{
+		digits.m_sign = '+';
+	}
+	else if (options.sign == FormatOptions::Sign::kSPACE)
+	{
+		digits.m_sign = ' ';
 	}
+}
 
-	SizeType posOfDecimalPoint{};
-	if (!isValid(str, posOfDecimalPoint))
+// Keeps the first keep digits, none when keep is negative, rounded half to even on the rest.
+// Returns true when the carry made one digit more.
+bool BigNumber::roundDigits(FormattedDigits& digits, const ScaleType keep)
+{
+	bool up = false;
+	if (keep >= 0)
 	{
-		LOG_ERROR("Invalid number.");
-		return;
+		const SizeType kept = static_cast<SizeType>(keep);
+		const char next = digits.m_digits[kept];
+		const bool odd = kept > 0 && ((digits.m_digits[kept - 1] - '0') & 1) != 0;
+		const bool sticky = std::any_of(digits.m_digits + kept + 1, digits.m_digits + digits.m_count, [](const char ch) { return ch != '0'; });
+		up = next > '5' || (next == '5' && (sticky || odd));
 	}
-	SizeType startPos = 0;
-	if (str[startPos] == '-')
+	digits.m_count = keep > 0 ? static_cast<SizeType>(keep) : 0;
+	if (!up)
 	{
-		m_bNegative = true;
-		startPos++;
+		// The kept digits may end in zeros, or there are none left for zero
+		return false;
 	}
-	if (str[posOfDecimalPoint] != '.')
+	SizeType i = digits.m_count;
+	while (i > 0 && digits.m_digits[i - 1] == '9')
 	{
-		m_szNumber = str.substr(startPos);
+		digits.m_digits[--i] = '0';
 	}
-	else
+	if (i > 0)
 	{
-		m_szNumber = str.substr(startPos, posOfDecimalPoint - startPos);
-		m_szFraction = str.substr(posOfDecimalPoint + 1);
+		digits.m_digits[i - 1]++;
+		return false;
 	}
-	trimZeros(m_szNumber);
-	trimZeros(m_szFraction, true);
-
-	roundOff(m_szNumber, m_szFraction, m_precision);
+	*--digits.m_digits = '1';
+	digits.m_count++;
+	return true;
+}
 
-	if (empty())
+BigNumber::SizeType BigNumber::formattedSize(const FormattedDigits& digits, const FormatOptions& options)
+{
+	const SizeType sign = digits.m_sign ? 1 : 0;
+	if (digits.m_text != nullptr)
 	{
-		m_bNegative = false;
-		LOG_ERROR("Invalid number.");
+		return sign + std::char_traits<char>::length(digits.m_text);
+	}
+	const SizeType fraction = digits.m_fraction ? digits.m_fraction + 1 : 0;
+	if (options.notation == FormatOptions::Notation::kSCIENTIFIC)
+	{
+		// d.ddde+XX, at least two digits of exponent
+		char exponent[24];
+		const std::to_chars_result result = std::to_chars(exponent, exponent + sizeof(exponent), digits.m_exponent < 0 ? -digits.m_exponent : digits.m_exponent);
+		return sign + 1 + fraction + 2 + std::max<SizeType>(static_cast<SizeType>(result.ptr - exponent), 2);
 	}
+	const ScaleType count = static_cast<ScaleType>(digits.m_count);
+	const SizeType integer = count > digits.m_exponent ? static_cast<SizeType>(count - digits.m_exponent) : 1;
+	const SizeType groups = options.groupSeparator && options.groupSize ? (integer - 1) / options.groupSize : 0;
+	return sign + integer + groups + fraction;
 }
 
-BigNumber BigNumber::add(const BigNumber& other) const
+char* BigNumber::writeFormatted(char* out, const FormattedDigits& digits, const FormatOptions& options)
 {
-	if (empty() || other.empty())
+	if (digits.m_sign)
 	{
-		LOG_ERROR("INVALID Operation!");
-		return BigNumber();
+		*out++ = digits.m_sign;
 	}
-
-	bool bNegative = false;
-	ValueType strFraction;
-	ValueType strNumber("0");
-
-	if (m_bNegative == other.m_bNegative)
+	if (digits.m_text != nullptr)
 	{
-		// Add but sign is negative
-		int carry{};
-		bNegative = m_bNegative;
-		strFraction = addHelper(m_szFraction, other.m_szFraction, carry, true);
-		strNumber = addHelper(m_szNumber, other.m_szNumber, carry);
+		const SizeType length = std::char_traits<char>::length(digits.m_text);
+		std::memcpy(out, digits.m_text, length);
+		return out + length;
 	}
-	else if (m_bNegative ^ other.m_bNegative)
+
+	if (options.notation == FormatOptions::Notation::kSCIENTIFIC)
 	{
-		int borrow{};
-		int cmpVal = compareStringAsNumber(m_szNumber, other.m_szNumber, false);
-		// subtract with sign if bigger number
-		if (cmpVal < 0)
+		*out++ = digits.m_count > 0 ? digits.m_digits[0] : '0';
+		if (digits.m_fraction)
 		{
-			strFraction = subHelper(other.m_szFraction, m_szFraction, borrow, true);
-			strNumber = subHelper(other.m_szNumber, m_szNumber, borrow);
-			bNegative = other.m_bNegative;
+			*out++ = '.';
+			const SizeType copied = std::min(digits.m_count > 0 ? digits.m_count - 1 : 0, digits.m_fraction);
+			std::memcpy(out, digits.m_digits + 1, copied);
+			std::fill(out + copied, out + digits.m_fraction, '0');
+			out += digits.m_fraction;
 		}
-		else if (cmpVal > 0)
+		*out++ = 'e';
+		*out++ = digits.m_exponent < 0 ? '-' : '+';
+		const ScaleType exponent = digits.m_exponent < 0 ? -digits.m_exponent : digits.m_exponent;
+		if (exponent < 10)
 		{
-			strFraction = subHelper(m_szFraction, other.m_szFraction, borrow, true);
-			strNumber = subHelper(m_szNumber, other.m_szNumber, borrow);
-			bNegative = m_bNegative;
+			*out++ = '0';
 		}
-		else
+		return std::to_chars(out, out + 24, exponent).ptr;
+	}
+
+	// The integer and fraction digits in a row, the digits start at first and zeros fill the rest
+	const ScaleType count = static_cast<ScaleType>(digits.m_count);
+	const ScaleType integer = count > digits.m_exponent ? count - digits.m_exponent : 1;
+	const ScaleType first = integer - count + digits.m_exponent;
+	const auto copyRun = [&digits, count, first](char* to, const ScaleType begin, const ScaleType end)
+	{
+		const ScaleType from = std::clamp(first, begin, end);
+		const ScaleType until = std::clamp(first + count, begin, end);
+		std::fill(to, to + (from - begin), '0');
+		std::memcpy(to + (from - begin), digits.m_digits + (from - first), static_cast<SizeType>(until - from));
+		std::fill(to + (until - begin), to + (end - begin), '0');
+		return to + (end - begin);
+	};
+	if (options.groupSeparator && options.groupSize)
+	{
+		const ScaleType group = static_cast<ScaleType>(std::min<SizeType>(options.groupSize, static_cast<SizeType>(INT64_MAX)));
+		ScaleType pos = integer % group ? integer % group : group;
+		out = copyRun(out, 0, pos);
+		for (; pos < integer; pos += group)
 		{
-			cmpVal = compareStringAsNumber(m_szFraction, other.m_szFraction, true);
-			if (cmpVal < 0)
-			{
-				strFraction = subHelper(other.m_szFraction, m_szFraction, borrow, true);
-			}
-			else if (cmpVal > 0)
-			{
-				strFraction = subHelper(m_szFraction, other.m_szFraction, borrow, true);
-			}
+			*out++ = options.groupSeparator;
+			out = copyRun(out, pos, pos + group);
 		}
 	}
-	return BigNumber(strNumber, strFraction, bNegative);
-}
-
-BigNumber BigNumber::multiply(const BigNumber& other) const
-{
-	if (empty() || other.empty())
-	{
-		LOG_ERROR("INVALID Operation!");
-		return BigNumber();
-	}
-	if (isEqual(0) || other.isEqual(0))
+	else
 	{
-		return BigNumber(0);
+		out = copyRun(out, 0, integer);
 	}
-	if (isEqual(1) || isEqual(-1))
+	if (digits.m_fraction)
 	{
-		return m_bNegative ? -other : other;
+		*out++ = '.';
+		out = copyRun(out, integer, integer + static_cast<ScaleType>(digits.m_fraction));
 	}
-	if (other.isEqual(1) || other.isEqual(-1))
+	return out;
+}
+
+BigNumber::SizeType BigNumber::formattedSize(const FormatOptions& options) const
+{
+	FormattedDigits digits;
+	formatDigits(digits, options);
+	return formattedSize(digits, options);
+}
+
+std::to_chars_result BigNumber::formatChars(char* first, char* last, const FormatOptions& options) const
+{
+	FormattedDigits digits;
+	formatDigits(digits, options);
+	if (static_cast<SizeType>(last - first) < formattedSize(digits, options))
 	{
-		return other.m_bNegative ? -(*this) : (*this);
+		return { last, std::errc::value_too_large };
 	}
-	return BigNumber(multiplyHelper(asString(true, true), other.asString(true, true)));
+	return { writeFormatted(first, digits, options), std::errc() };
 }
 
-BigNumber BigNumber::divide(const BigNumber& other) const
+BigNumber::ValueType BigNumber::formatString(const FormatOptions& options) const
 {
-	if (empty() || other.empty())
+	FormattedDigits digits;
+	formatDigits(digits, options);
+	ValueType szRet(formattedSize(digits, options), '\0');
+	writeFormatted(&szRet[0], digits, options);
+	return szRet;
+}
+
+void BigNumber::writeTo(std::ostream& out) const
+{
+	const FormatOptions options;
+	FormattedDigits digits;
+	formatDigits(digits, options);
+	const SizeType size = formattedSize(digits, options);
+	// Laid out next to the digits when they fit there
+	char stack[sizeof(digits.m_stack)];
+	ValueType heap;
+	char* buffer = stack;
+	if (size > sizeof(stack))
+	{
+		heap.resize(size);
+		buffer = &heap[0];
+	}
+	writeFormatted(buffer, digits, options);
+	out << std::string_view(buffer, size) << '\n';
+}
+
+std::from_chars_result BigNumber::parseChars(const char* first, const char* last, const char groupSeparator)
+{
+	const char* pos = first;
+	const bool negative = pos < last && *pos == '-';
+	if (pos < last && (*pos == '-' || *pos == '+'))
 	{
-		LOG_ERROR("INVALID Operation!");
-		return sNAN;
+		pos++;
 	}
-	if (isEqual(0))
+	const auto isDigit = [last](const char* at) { return at < last && *at >= '0' && *at <= '9'; };
+	const auto startsWith = [&pos, last](const char* word, const SizeType length)
 	{
-		return BigNumber(0);
-	}
-	if (other.isEqual(0))
+		return static_cast<SizeType>(last - pos) >= length && std::memcmp(pos, word, length) == 0;
+	};
+	if (!isDigit(pos) && !(pos < last && *pos == '.'))
 	{
-		return sDIVIDE_BY_ZERO;
+		// NAN has no sign, as in parse
+		const bool nan = !negative && pos == first && startsWith("NAN", 3);
+		if (!nan && !startsWith("INFINITY", 8))
+		{
+			return { first, std::errc::invalid_argument };
+		}
+		m_limbs.clear();
+		m_scale = 0;
+		m_bNegative = !nan && negative;
+		m_state = nan ? State::kNAN : State::kINFINITY;
+		return { pos + (nan ? 3 : 8), std::errc() };
 	}
-	if (other.isEqual(1) || other.isEqual(-1))
+
+	// Integer digits, a separator only between two of them, then the fraction
+	const char* mantissa = pos;
+	SizeType integerDigits = 0;
+	while (isDigit(pos) || (groupSeparator && pos < last && *pos == groupSeparator && integerDigits > 0 && isDigit(pos + 1)))
 	{
-		return (m_bNegative == other.m_bNegative) ? (*this) : -(*this);
+		integerDigits += *pos++ != groupSeparator ? 1 : 0;
 	}
-	if (isEqual(other))
+	SizeType fractionDigits = 0;
+	if (pos < last && *pos == '.')
 	{
-		return BigNumber("1");
+		while (isDigit(pos + 1 + fractionDigits))
+		{
+			fractionDigits++;
+		}
+		if (integerDigits == 0 && fractionDigits == 0)
+		{
+			return { first, std::errc::invalid_argument };
+		}
+		pos += 1 + fractionDigits;
 	}
-	if (isEqual(-other))
+	const char* mantissaEnd = pos;
+
+	// The exponent only counts with a digit in it
+	ScaleType exponent = 0;
+	bool outOfRange = false;
+	if (pos < last && (*pos == 'e' || *pos == 'E'))
 	{
-		return BigNumber("-1");
+		const char* at = pos + 1;
+		const bool negativeExponent = at < last && *at == '-';
+		if (at < last && (*at == '-' || *at == '+'))
+		{
+			at++;
+		}
+		if (isDigit(at))
+		{
+			for (; isDigit(at); ++at)
+			{
+				outOfRange = outOfRange || exponent > static_cast<ScaleType>(kMAX_RESULT_DIGITS);
+				exponent = outOfRange ? exponent : exponent * 10 + (*at - '0');
+			}
+			outOfRange = outOfRange || exponent > static_cast<ScaleType>(kMAX_RESULT_DIGITS);
+			exponent = negativeExponent ? -exponent : exponent;
+			pos = at;
+		}
 	}
-	if (isInteger() && other.isInteger())
+	if (outOfRange)
 	{
-		ValueType rem;
-		return BigNumber(((m_bNegative == other.m_bNegative) ? "" : "-") + divideAsIntegers(m_szNumber, other.m_szNumber, rem));
+		return { pos, std::errc::result_out_of_range };
 	}
-	return BigNumber(((m_bNegative == other.m_bNegative) ? "" : "-") + divideAsFloatingPoint(m_szNumber, m_szFraction, other.m_szNumber, other.m_szFraction));
-}
 
-BigNumber BigNumber::modulo(const BigNumber& other) const
-{
-	if (empty() || other.empty())
-	{
-		LOG_ERROR("INVALID Operation!");
-		return BigNumber();
-	}
-	if (isEqual(0) || other.isEqual(1))
+	// Digit i is worth 10^(integerDigits - 1 - i + exponent), those below 10^-precision only round
+	const SizeType total = integerDigits + fractionDigits;
+	const ScaleType integer = static_cast<ScaleType>(integerDigits);
+	const ScaleType precision = static_cast<ScaleType>(std::min<SizeType>(m_precision, total + static_cast<SizeType>(std::abs(exponent)) + 1));
+	const ScaleType wanted = integer + exponent + precision;
+	const SizeType keep = static_cast<SizeType>(std::clamp<ScaleType>(wanted, 0, static_cast<ScaleType>(total)));
+
+	m_limbs.clear();
+	const char* digit = mantissa;
+	const auto nextDigit = [&digit]()
 	{
-		return BigNumber("0");
-	}
-	if (other.isEqual(0))
+		while (*digit < '0' || *digit > '9')
+		{
+			digit++;
+		}
+		return *digit++;
+	};
+	if (nsLimb::kDECIMAL_LIMBS || keep <= nsLimb::kFROM_DECIMAL_THRESHOLD * nsLimb::kDECIMAL_BLOCK_DIGITS)
 	{
-		return sDIVIDE_BY_ZERO;
+		// Block by block into the limbs already there, so a value that was as long takes no allocation
+		for (SizeType done = 0; done < keep;)
+		{
+			const unsigned blockSize = static_cast<unsigned>(std::min<SizeType>(keep - done, nsLimb::kDECIMAL_BLOCK_DIGITS));
+			Limb block = 0;
+			for (unsigned i = 0; i < blockSize; ++i)
+			{
+				block = block * 10 + static_cast<Limb>(nextDigit() - '0');
+			}
+			done += blockSize;
+			Limb carry = nsLimb::mulLimb(m_limbs.data(), m_limbs.data(), m_limbs.size(), nsLimb::pow10Limb(blockSize));
+			if (carry)
+			{
+				m_limbs.push_back(carry);
+			}
+			carry = nsLimb::addLimb(m_limbs.data(), m_limbs.data(), m_limbs.size(), block);
+			if (carry)
+			{
+				m_limbs.push_back(carry);
+			}
+		}
+		nsLimb::normalize(m_limbs);
 	}
-	if (isEqual(other) || isEqual(-other))
+	else
 	{
-		return BigNumber("0");
+		ValueType kept(keep, '0');
+		for (char& ch : kept)
+		{
+			ch = nextDigit();
+		}
+		m_limbs = nsLimb::fromDecimal(kept.data(), kept.size());
 	}
 
-	ValueType rem;
-	if (!isFloatingPoint() && !other.isFloatingPoint())
-	{
-		divideAsIntegers(m_szNumber, other.m_szNumber, rem);
-	}
-	else
+	// Half to even on the first digit left out and whether any after it is non zero,
+	// nothing to round when all of them lie below that digit
+	if (keep < total && wanted >= 0)
 	{
-		divideAsIntegers(asString(false, false), other.asString(false, false), rem);
-		const SizeType decimalPos = m_szFraction.size() + other.m_szFraction.size();
-		if (rem.size() < decimalPos)
+		const bool odd = keep > 0 && ((*(digit - 1) - '0') & 1) != 0;
+		const char next = nextDigit();
+		bool sticky = false;
+		for (; digit < mantissaEnd && !sticky; ++digit)
+		{
+			sticky = *digit >= '1' && *digit <= '9';
+		}
+		if (next > '5' || (next == '5' && (sticky || odd)))
 		{
-			rem.insert(0, decimalPos - rem.size(), '0');
+			if (nsLimb::addLimb(m_limbs.data(), m_limbs.data(), m_limbs.size(), 1) || m_limbs.empty())
+			{
+				m_limbs.push_back(1);
+			}
 		}
-		rem.insert(rem.size() - decimalPos, 1, '0');
 	}
-	return BigNumber((other.isNegative() ? "-" : "") + rem);
+	m_scale = static_cast<ScaleType>(keep) - integer - exponent;
+	m_bNegative = negative;
+	m_state = State::kFINITE;
+	trimZeros();
+	return { pos, std::errc() };
 }
 
-BigNumber BigNumber::power(const BigNumber& exp) const
+int BigNumber::compare(const BigNumber& other) const
 {
-	if (empty() || exp.empty())
+	if (m_bNegative != other.m_bNegative)
 	{
-		LOG_ERROR("INVALID Operation!");
-		return BigNumber();
+		return m_bNegative ? -1 : 1;
 	}
+	const int cmpVal = compareMagnitude(other);
+	return m_bNegative ? -cmpVal : cmpVal;
+}
 
-	if (isEqual(0))
+int BigNumber::compareMagnitude(const BigNumber& other) const
+{
+	if (m_scale == other.m_scale)
 	{
-		return exp.m_bNegative ? sNAN : BigNumber("0");
+		return nsLimb::compare(m_limbs, other.m_limbs);
 	}
-	if (isEqual(1))
+	const ScaleType scale = std::max(m_scale, other.m_scale);
+	DoubleLimb lhs{};
+	DoubleLimb rhs{};
+	if (nativeMagnitude(scale, lhs) && other.nativeMagnitude(scale, rhs))
 	{
-		return BigNumber(1);
+		return lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
 	}
-	if (exp.isEqual(1))
+	if (m_scale < other.m_scale)
 	{
-		return (*this);
+		return nsLimb::compare(scaledMagnitude(other.m_scale), other.m_limbs);
 	}
-	if (exp.isEqual(0))
+	return nsLimb::compare(m_limbs, other.scaledMagnitude(m_scale));
+}
+
+bool BigNumber::isEqual(const BigNumber& other) const
+{
+	if (m_state != State::kFINITE || other.m_state != State::kFINITE)
 	{
-		return BigNumber("1");
+		return m_state == other.m_state && m_bNegative == other.m_bNegative;
 	}
-	if (exp.isNegative())
+	return compare(other) == 0;
+}
+
+template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool>>
+bool BigNumber::isLessThan(const Number other) const
+{
+	if constexpr (std::is_integral<Number>::value)
 	{
-		const std::pair<ValueType, ValueType> p = split_at( static_cast<ValueType>( this->power( -exp)) );
-		return BigNumber(divideAsFloatingPoint("1", "", p.first, p.second));
+		if (!isFinite())
+		{
+			return m_state == State::kINFINITY && m_bNegative;
+		}
+		return compareInteger(magnitudeOf(other), isNegativeNative(other)) < 0;
 	}
-	bool bNegative{ false };
-	if (m_bNegative && !exp.isEven())
+	else
 	{
-		bNegative = true;
+		return isLessThan(BigNumber(other));
 	}
+}
 
-	ValueType szAns = powerHelperIntegerExponent(asString(false, true), exp.m_szNumber);
-	if (exp.isFloatingPoint())
-	{	
-		szAns = multiplyHelper(szAns, nth_Root(asString(false, true), exp.m_szFraction));
+template <typename Number, std::enable_if_t<std::is_floating_point<Number>::value || std::is_integral<Number>::value, bool>>
+bool BigNumber::isEqual(const Number other) const
+{
+	if constexpr (std::is_integral<Number>::value)
+	{
+		return isFinite() && compareInteger(magnitudeOf(other), isNegativeNative(other)) == 0;
+	}
+	else
+	{
+		return isEqual(BigNumber(other));
 	}
-	//If n is an even integer, then(−1)n = 1.
-	//If n is an odd integer, then(−1)n = −1.
-	return BigNumber((bNegative ? "-" : "") + szAns);
 }
 
-BigNumber::ValueType BigNumber::addHelper(const ValueType &in1, const ValueType &in2) const
+template <typename T>
+bool BigNumber::asInteger(T& val, const ValueType &str, const bool quiet) const
 {
-	const std::pair<ValueType, ValueType> p1 = split_at(in1);
-	const std::pair<ValueType, ValueType> p2 = split_at(in2);
-	int carry = 0;
-	ValueType szAns;
-	if (!p1.second.empty() || !p2.second.empty())
+	val = static_cast<T>(0);
+	if (!str.empty())
+	{
+		return BigNumber(str).asInteger(val, "", quiet);
+	}
+	if (m_state != State::kFINITE)
+	{
+		if (!quiet)
+		{
+			LOG_ERROR("Exception : Not a finite number.");
+		}
+		return false;
+	}
+
+	// Same range as std::stoll, integer part only
+	LimbVector integerPart(m_limbs);
+	if (m_scale > 0)
 	{
-		szAns = addHelper(p1.second, p2.second, carry, true);
-		trimZeros(szAns, true);
-		szAns.insert(0, 1, '.');
+		LimbVector remainder;
+		nsLimb::divideByPow10(m_limbs, fractionDigits(), integerPart, remainder);
 	}
-	szAns.insert(0, addHelper(p1.first, p2.first, carry, false));
-	trimZeros(szAns);
-	
-	roundOff(szAns, m_precision);
-	if (szAns.find('.') == 0)
+	else if (m_scale < 0 && !m_limbs.empty())
 	{
-		szAns.insert(0, 1, '0');
+		// Beyond 10^19 the value is out of range anyway
+		if (-m_scale > static_cast<ScaleType>(nsLimb::kDECIMAL_BLOCK_DIGITS))
+		{
+			if (!quiet)
+			{
+				LOG_ERROR("Exception : Out of range.");
+			}
+			return false;
+		}
+		integerPart = scaledMagnitude(0);
 	}
-	return szAns;
+	const Limb kMAX = static_cast<Limb>(LLONG_MAX) + (m_bNegative ? 1 : 0);
+	if (integerPart.size() > 1 || (!integerPart.empty() && integerPart[0] > kMAX))
+	{
+		if (!quiet)
+		{
+			LOG_ERROR("Exception : Out of range.");
+		}
+		return false;
+	}
+	const Limb magnitude = integerPart.empty() ? 0 : integerPart[0];
+	const long long signedValue = m_bNegative ? static_cast<long long>(0 - magnitude) : static_cast<long long>(magnitude);
+	val = static_cast<T>(signedValue);
+	return true;
 }
 
-BigNumber::ValueType BigNumber::subHelper(const ValueType &in1, const ValueType &in2) const
+template <typename T>
+bool BigNumber::asFloatingPoint(T& val, const ValueType &str, const bool quiet) const
 {
-	int cmpVal = compareStringAsNumber(in1, in2);
-	if (cmpVal < 0)
+	val = static_cast<T>( 0.0 );
+	try
 	{
-		return subHelper(in2, in1);
+		val = str.empty() ? static_cast<T>(std::stold(asString(true, true))) : static_cast<T>(std::stold(str));
 	}
-	else if (cmpVal == 0)
+	catch (std::exception& e)
 	{
-		return "0";
+		if (!quiet)
+		{
+			LOG_ERROR("Exception : " + ValueType(e.what()));
+		}
+		return false;
 	}
+	return true;
+}
 
-	const std::pair<ValueType, ValueType> p1 = split_at(in1);
-	const std::pair<ValueType, ValueType> p2 = split_at(in2);
-	
-	int borrow = 0;
-	ValueType szAns;
-	if (!p1.second.empty() || !p2.second.empty())
+void BigNumber::copyFrom(const BigNumber& other)
+{
+	if (this != &other)
 	{
-		szAns = subHelper(p1.second, p2.second, borrow, true);
-		trimZeros(szAns, true);
-		szAns.insert(0, 1, '.');
+		m_limbs = other.m_limbs;
+		m_bNegative = other.m_bNegative;
+		m_scale = other.m_scale;
+		m_state = other.m_state;
+		m_precision = other.m_precision;
 	}
-	szAns.insert(0, subHelper(p1.first, p2.first, borrow, false));
-	trimZeros(szAns);
-	roundOff(szAns, m_precision);
-	if (szAns.find('.') == 0)
+}
+
+void BigNumber::moveFrom(BigNumber&& other)
+{
+	assert(this != &other);
+	m_limbs = std::exchange(other.m_limbs, LimbVector());
+	m_scale = std::exchange(other.m_scale, 0);
+	m_bNegative = std::exchange(other.m_bNegative, false);
+	m_state = std::exchange(other.m_state, State::kEMPTY);
+	m_precision = other.m_precision;
+}
+
+bool BigNumber::isValid(const ValueType& str, SizeType& posOfDecimalPoint) const
+{
+	if (str.empty())
 	{
-		szAns.insert(0, 1, '0');
+		return false;
 	}
-	return szAns;
+	posOfDecimalPoint = 0;
+	SizeType i = (str[0] == '-' ? 1 : 0);
+	bool decimalPoint = false;
+	bool digit = false;
+	while (i < str.size())
+	{
+		if (str[i] == '.')
+		{
+			if (decimalPoint)
+			{
+				return false;
+			}
+			decimalPoint = true;
+			posOfDecimalPoint = i;
+		}
+		else if (!std::isdigit(static_cast<unsigned char>(str[i])))
+		{
+			return false;
+		}
+		else
+		{
+			digit = true;
+		}
+		i++;
+	}
+	return digit;
 }
 
-BigNumber::ValueType BigNumber::addHelper(ValueType in1, ValueType in2, int& carry, const bool isFractionPart) const
+void BigNumber::parse(const ValueType& str)
 {
-	ValueType szAns;
-	if (in1.empty() && in2.empty())
+	clear();
+
+	if (str == "NAN")
 	{
-		return szAns;
+		m_state = State::kNAN;
+		return;
 	}
-	else if (in1.empty() || in2.empty())
+	if (str == "INFINITY" || str == "-INFINITY")
 	{
-		szAns = in1.empty() ? in2 : in1;
-		return szAns;
+		m_state = State::kINFINITY;
+		m_bNegative = str[0] == '-';
+		return;
 	}
-	
-	makeEqualLength(in1, in2, isFractionPart);
-	szAns.reserve(in1.size() + 1);
 
-	if (isFractionPart)
+	SizeType posOfDecimalPoint{};
+	if (!isValid(str, posOfDecimalPoint))
 	{
-		carry = 0;
+		LOG_ERROR("Invalid number.");
+		return;
+	}
+	SizeType startPos = 0;
+	if (str[startPos] == '-')
+	{
+		m_bNegative = true;
+		startPos++;
 	}
 
-	ValueType str;
-	SizeType rt = in1.size();
-	for (SizeType lt = 0; rt > kBLOCK_SIZE; rt -= kBLOCK_SIZE)
+	ValueType digits;
+	if (str[posOfDecimalPoint] != '.')
 	{
-		lt = rt - kBLOCK_SIZE;
-		lt = lt > rt ? 0 : lt;
-		str = std::to_string(stoll_s(in1.substr(lt, kBLOCK_SIZE)) + stoll_s(in2.substr(lt, kBLOCK_SIZE)) + carry);
-		if (str.size() < kBLOCK_SIZE)
+		digits = str.substr(startPos);
+	}
+	else
+	{
+		// Trailing zeros of the fraction carry no value
+		SizeType endPos = str.size();
+		while (endPos > posOfDecimalPoint + 1 && str[endPos - 1] == '0')
 		{
-			str.insert(0, kBLOCK_SIZE - str.size(), '0');
+			endPos--;
 		}
-		carry = 0;
-		if (str.size() > kBLOCK_SIZE)
+		digits = str.substr(startPos, posOfDecimalPoint - startPos);
+		digits.append(str, posOfDecimalPoint + 1, endPos - posOfDecimalPoint - 1);
+		m_scale = static_cast<ScaleType>(endPos - posOfDecimalPoint - 1);
+	}
+	m_limbs = nsLimb::fromDecimal(digits.data(), digits.size());
+	m_state = State::kFINITE;
+
+	roundOff(m_precision);
+	trimZeros();
+}
+
+template <typename Number>
+bool BigNumber::isNegativeNative(const Number number)
+{
+	if constexpr (std::is_signed<Number>::value)
+	{
+		return number < 0;
+	}
+	else
+	{
+		static_cast<void>(number);
+		return false;
+	}
+}
+
+template <typename Number>
+uint64_t BigNumber::magnitudeOf(const Number number)
+{
+	const uint64_t value = static_cast<uint64_t>(number);
+	return isNegativeNative(number) ? 0 - value : value;
+}
+
+BigNumber BigNumber::fromInteger(const uint64_t magnitude, const bool negative)
+{
+	BigNumber result;
+	nsLimb::fromDoubleLimb(magnitude, result.m_limbs);
+	result.m_bNegative = negative && magnitude != 0;
+	return result;
+}
+
+// Builds the number straight from its binary value, floating point is rounded to m_precision places
+template <typename Number>
+void BigNumber::assignNative(const Number number)
+{
+	clear();
+	m_state = State::kFINITE;
+	if constexpr (std::is_integral<Number>::value)
+	{
+		m_bNegative = isNegativeNative(number);
+		nsLimb::fromDoubleLimb(magnitudeOf(number), m_limbs);
+	}
+	else
+	{
+		if (std::isnan(number))
 		{
-			carry = to_int(str[0]);
-			str.erase(str.begin());
+			m_state = State::kNAN;
+			return;
 		}
-		szAns.insert(0, str);
+		if (std::isinf(number))
+		{
+			m_state = State::kINFINITY;
+			m_bNegative = number < 0;
+			return;
+		}
+
+		// number = mantissa * 2^exp2 exactly, 2^-k is then 5^k / 10^k
+		int exp2 = 0;
+		const long double frac = std::frexp(std::fabs(static_cast<long double>(number)), &exp2);
+		Limb mantissa = static_cast<Limb>(std::ldexp(frac, static_cast<int>(nsLimb::kLIMB_BITS)));
+		if (mantissa == 0)
+		{
+			return;
+		}
+		const int zeros = __builtin_ctzll(mantissa);
+		mantissa >>= zeros;
+		exp2 += zeros - static_cast<int>(nsLimb::kLIMB_BITS);
+
+		m_bNegative = number < 0;
+		nsLimb::fromDoubleLimb(mantissa, m_limbs);
+		if (exp2 >= 0)
+		{
+			nsLimb::multiplyByPower(m_limbs, 2, static_cast<SizeType>(exp2));
+		}
+		else
+		{
+			nsLimb::multiplyByPower(m_limbs, 5, static_cast<SizeType>(-exp2));
+			m_scale = -exp2;
+		}
+		roundOff(m_precision);
+		trimZeros();
+	}
+}
+
+template <typename Number>
+void BigNumber::addNative(const Number number, const bool subtract)
+{
+	if constexpr (std::is_integral<Number>::value)
+	{
+		addInteger(magnitudeOf(number), isNegativeNative(number) != subtract);
 	}
-	str = std::to_string(stoll_s(in1.substr(0, rt)) + stoll_s(in2.substr(0, rt)) + carry);
-	carry = 0;
-	if (isFractionPart && str.size() > rt)
+	else
 	{
-		carry = to_int(str[0]);
-		str.erase(str.begin());
+		(*this) = add(BigNumber(subtract ? -number : number));
 	}
-	szAns.insert(0, str);
-	return szAns;
 }
 
-BigNumber::ValueType BigNumber::subHelper(ValueType in1, ValueType in2, int& borrow, const bool isFractionPart) const
+template <typename Number>
+void BigNumber::multiplyNative(const Number number)
 {
-	ValueType szAns;
-	if (in1.empty() && in2.empty())
+	if constexpr (std::is_integral<Number>::value)
 	{
-		return szAns;
+		multiplyInteger(magnitudeOf(number), isNegativeNative(number));
 	}
-	else if (in2.empty())
+	else
 	{
-		szAns = in1;
-		return szAns;
+		(*this) = multiply(BigNumber(number));
 	}
-	else if (in1.empty())
+}
+
+template <typename Number>
+void BigNumber::divideNative(const Number number)
+{
+	if constexpr (std::is_integral<Number>::value)
 	{
-		szAns = in2;
-		return szAns;
+		divideInteger(magnitudeOf(number), isNegativeNative(number));
 	}
+	else
+	{
+		(*this) = divide(BigNumber(number));
+	}
+}
 
-	makeEqualLength(in1, in2, isFractionPart);
-	szAns.reserve(in1.size());
-	if (isFractionPart)
+template <typename Number>
+void BigNumber::moduloNative(const Number number)
+{
+	if constexpr (std::is_integral<Number>::value)
 	{
-		borrow = 0;
+		moduloInteger(magnitudeOf(number), isNegativeNative(number));
 	}
+	else
+	{
+		(*this) = modulo(BigNumber(number));
+	}
+}
 
-	ValueType str;
-	ValueType sz1;
-	ValueType sz2;
-	str.reserve(kBLOCK_SIZE);
-	sz1.reserve(kBLOCK_SIZE);
-	sz2.reserve(kBLOCK_SIZE);
+// In place, same result as add(BigNumber(value))
+void BigNumber::addInteger(const uint64_t magnitude, const bool negative)
+{
+	if (!isFinite() || m_scale < 0)
+	{
+		(*this) = add(fromInteger(magnitude, negative));
+		return;
+	}
+	LimbVector other;
+	nsLimb::fromDoubleLimb(magnitude, other);
+	nsLimb::multiplyByPow10(other, fractionDigits());
+	if (isZero())
+	{
+		m_bNegative = negative;
+	}
+	if (m_bNegative == negative)
+	{
+		if (m_limbs.size() < other.size())
+		{
+			m_limbs.resize(other.size());
+		}
+		const Limb carry = nsLimb::add(m_limbs.data(), m_limbs.data(), m_limbs.size(), other.data(), other.size());
+		if (carry)
+		{
+			m_limbs.push_back(carry);
+		}
+	}
+	else if (nsLimb::compare(m_limbs, other) >= 0)
+	{
+		nsLimb::sub(m_limbs.data(), m_limbs.data(), m_limbs.size(), other.data(), other.size());
+		nsLimb::normalize(m_limbs);
+	}
+	else
+	{
+		m_limbs = subHelper(other, m_limbs);
+		m_bNegative = negative;
+	}
+	roundOff(m_precision);
+	trimZeros();
+}
+
+// In place, same result as multiply(BigNumber(value))
+void BigNumber::multiplyInteger(const uint64_t magnitude, const bool negative)
+{
+	if (!isFinite())
+	{
+		(*this) = multiply(fromInteger(magnitude, negative));
+		return;
+	}
+	if (magnitude == 0 || isZero())
+	{
+		m_limbs.clear();
+		m_scale = 0;
+		m_bNegative = false;
+		return;
+	}
+	m_bNegative = (m_bNegative != negative);
+	if (magnitude <= nsLimb::kLIMB_MAX)
+	{
+		const Limb carry = nsLimb::mulLimb(m_limbs.data(), m_limbs.data(), m_limbs.size(), magnitude);
+		if (carry)
+		{
+			m_limbs.push_back(carry);
+		}
+	}
+	else
+	{
+		LimbVector other;
+		nsLimb::fromDoubleLimb(magnitude, other);
+		m_limbs = multiplyHelper(m_limbs, other);
+	}
+	roundOff(m_precision);
+	trimZeros();
+}
 
-	SizeType rt = in1.size();
-	for (SizeType lt = 0; rt > kBLOCK_SIZE; rt -= kBLOCK_SIZE)
+// In place, same result as divide(BigNumber(value))
+void BigNumber::divideInteger(const uint64_t magnitude, const bool negative)
+{
+	if (!isFinite() || isZero() || m_scale != 0 || magnitude == 0 || magnitude > nsLimb::kLIMB_MAX)
 	{
-		lt = rt - kBLOCK_SIZE;
-		lt = lt > rt ? 0 : lt;
+		(*this) = divide(fromInteger(magnitude, negative));
+		return;
+	}
+	nsLimb::divRemLimb(m_limbs.data(), m_limbs.data(), m_limbs.size(), magnitude);
+	nsLimb::normalize(m_limbs);
+	m_bNegative = (m_bNegative != negative) && !m_limbs.empty();
+}
 
-		sz1 = in1.substr(lt, kBLOCK_SIZE);
-		sz2 = in2.substr(lt, kBLOCK_SIZE);
-		if (borrow)
+// In place, same result as modulo(BigNumber(value))
+void BigNumber::moduloInteger(const uint64_t magnitude, const bool negative)
+{
+	if (!isFinite() || m_scale != 0 || magnitude == 0 || magnitude > nsLimb::kLIMB_MAX)
+	{
+		(*this) = modulo(fromInteger(magnitude, negative));
+		return;
+	}
+	const Limb remainder = nsLimb::modLimb(m_limbs.data(), m_limbs.size(), magnitude);
+	nsLimb::fromDoubleLimb(remainder, m_limbs);
+	m_bNegative = negative && remainder != 0;
+}
+
+// Same as compare(BigNumber(value)), this has to be finite
+int BigNumber::compareInteger(const uint64_t magnitude, const bool negative) const
+{
+	const bool otherNegative = negative && magnitude != 0;
+	if (m_bNegative != otherNegative)
+	{
+		return m_bNegative ? -1 : 1;
+	}
+	int cmpVal = 0;
+	DoubleLimb lhs{};
+	DoubleLimb rhs = magnitude;
+	if (nativeMagnitude(std::max<ScaleType>(m_scale, 0), lhs) && nsLimb::multiplyByPow10(rhs, fractionDigits()))
+	{
+		cmpVal = lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
+	}
+	else if (m_scale < 0)
+	{
+		// An integer beyond 128 bits
+		cmpVal = 1;
+	}
+	else
+	{
+		LimbVector other;
+		nsLimb::fromDoubleLimb(magnitude, other);
+		nsLimb::multiplyByPow10(other, fractionDigits());
+		cmpVal = nsLimb::compare(m_limbs, other);
+	}
+	return m_bNegative ? -cmpVal : cmpVal;
+}
+
+BigNumber BigNumber::add(const BigNumber& other) const
+{
+	if (empty() || other.empty())
+	{
+		LOG_ERROR("INVALID Operation!");
+		return BigNumber();
+	}
+	if (!isFinite() || !other.isFinite())
+	{
+		if (m_state == State::kNAN || other.m_state == State::kNAN
+			|| (m_state == other.m_state && m_bNegative != other.m_bNegative))
 		{
-			increment(sz2);
-			borrow = 0;
+			return sNAN;
 		}
-		int cmpVal = compareStringAsNumber(sz1, sz2, false);
-		if (cmpVal > 0)
+		return isFinite() ? other : (*this);
+	}
+
+	BigNumber result;
+	result.m_precision = m_precision;
+	result.m_scale = std::max(m_scale, other.m_scale);
+
+	DoubleLimb lhsNative{};
+	DoubleLimb rhsNative{};
+	DoubleLimb sum{};
+	if (nativeMagnitude(result.m_scale, lhsNative) && other.nativeMagnitude(result.m_scale, rhsNative)
+		&& (m_bNegative != other.m_bNegative || !__builtin_add_overflow(lhsNative, rhsNative, &sum)))
+	{
+		// Both fit in 128 bits, no limb arrays needed
+		if (m_bNegative == other.m_bNegative)
 		{
-			str = std::to_string(stoll_s(sz1) - stoll_s(sz2));
+			result.m_bNegative = m_bNegative;
+			nsLimb::fromDoubleLimb(sum, result.m_limbs);
 		}
-		else if (cmpVal < 0)
+		else if (lhsNative < rhsNative)
 		{
-			if (sz1.size() != sz2.size())
-			{
-				makeEqualLength(sz1, sz2);
-			}
-			sz1.insert(0, 1, '1');
-			str = std::to_string(stoll_s(sz1) - stoll_s(sz2));
-			borrow = 1;
+			result.m_bNegative = other.m_bNegative;
+			nsLimb::fromDoubleLimb(rhsNative - lhsNative, result.m_limbs);
+		}
+		else
+		{
+			result.m_bNegative = m_bNegative;
+			nsLimb::fromDoubleLimb(lhsNative - rhsNative, result.m_limbs);
+		}
+		result.roundOff(m_precision);
+		result.trimZeros();
+		return result;
+	}
+
+	const LimbVector lhs = scaledMagnitude(result.m_scale);
+	const LimbVector rhs = other.scaledMagnitude(result.m_scale);
+	if (m_bNegative == other.m_bNegative)
+	{
+		// Add but sign is negative
+		result.m_bNegative = m_bNegative;
+		result.m_limbs = addHelper(lhs, rhs);
+	}
+	else
+	{
+		// subtract with sign of bigger number
+		const int cmpVal = nsLimb::compare(lhs, rhs);
+		if (cmpVal < 0)
+		{
+			result.m_limbs = subHelper(rhs, lhs);
+			result.m_bNegative = other.m_bNegative;
+		}
+		else if (cmpVal > 0)
+		{
+			result.m_limbs = subHelper(lhs, rhs);
+			result.m_bNegative = m_bNegative;
+		}
+	}
+	result.roundOff(m_precision);
+	result.trimZeros();
+	return result;
+}
+
+BigNumber BigNumber::multiply(const BigNumber& other) const
+{
+	if (empty() || other.empty())
+	{
+		LOG_ERROR("INVALID Operation!");
+		return BigNumber();
+	}
+	if (!isFinite() || !other.isFinite())
+	{
+		if (m_state == State::kNAN || other.m_state == State::kNAN || isZero() || other.isZero())
+		{
+			return sNAN;
 		}
-		if (str.size() < kBLOCK_SIZE)
+		return (m_bNegative == other.m_bNegative) ? sINFINITY : -sINFINITY;
+	}
+
+	BigNumber result;
+	result.m_precision = m_precision;
+	if (isZero() || other.isZero())
+	{
+		return result;
+	}
+	result.m_bNegative = (m_bNegative != other.m_bNegative);
+	result.m_scale = m_scale + other.m_scale;
+	DoubleLimb lhs{};
+	DoubleLimb rhs{};
+	DoubleLimb product{};
+	if (nsLimb::toDoubleLimb(m_limbs, lhs) && nsLimb::toDoubleLimb(other.m_limbs, rhs) && !__builtin_mul_overflow(lhs, rhs, &product))
+	{
+		nsLimb::fromDoubleLimb(product, result.m_limbs);
+	}
+	else if (!result.roundedShortProduct(m_limbs, other.m_limbs))
+	{
+		result.m_limbs = multiplyHelper(m_limbs, other.m_limbs);
+	}
+	result.roundOff(m_precision);
+	result.trimZeros();
+	return result;
+}
+
+// Same as multiply(*this) but only about half the partial products are computed
+BigNumber BigNumber::square() const
+{
+	if (empty())
+	{
+		LOG_ERROR("INVALID Operation!");
+		return BigNumber();
+	}
+	if (!isFinite())
+	{
+		return m_state == State::kNAN ? sNAN : sINFINITY;
+	}
+
+	BigNumber result;
+	result.m_precision = m_precision;
+	if (isZero())
+	{
+		return result;
+	}
+	result.m_scale = 2 * m_scale;
+	DoubleLimb val{};
+	DoubleLimb product{};
+	if (nsLimb::toDoubleLimb(m_limbs, val) && !__builtin_mul_overflow(val, val, &product))
+	{
+		nsLimb::fromDoubleLimb(product, result.m_limbs);
+	}
+	else if (!result.roundedShortProduct(m_limbs, m_limbs))
+	{
+		result.m_limbs = squareHelper(m_limbs);
+	}
+	result.roundOff(m_precision);
+	result.trimZeros();
+	return result;
+}
+
+BigNumber BigNumber::divide(const BigNumber& other) const
+{
+	if (empty() || other.empty())
+	{
+		LOG_ERROR("INVALID Operation!");
+		return sNAN;
+	}
+	if (!isFinite() || !other.isFinite())
+	{
+		return sNAN;
+	}
+	if (isZero())
+	{
+		return BigNumber(0);
+	}
+	if (other.isZero())
+	{
+		return sDIVIDE_BY_ZERO;
+	}
+	if (isInteger() && other.isInteger())
+	{
+		// Only the difference of the zeros held in the scales is multiplied out
+		BigNumber result;
+		result.m_precision = m_precision;
+		const ScaleType scale = std::max(m_scale, other.m_scale);
+		DoubleLimb num{};
+		DoubleLimb den{};
+		if (nativeMagnitude(scale, num) && other.nativeMagnitude(scale, den))
+		{
+			nsLimb::fromDoubleLimb(num / den, result.m_limbs);
+		}
+		else
 		{
-			str.insert(0, kBLOCK_SIZE - str.size(), '0');
+			LimbVector remainder;
+			result.m_limbs = divideAsIntegers(scaledMagnitude(scale), other.scaledMagnitude(scale), remainder);
 		}
-		szAns.insert(0, str);
-		str.clear();
+		result.m_bNegative = (m_bNegative != other.m_bNegative) && !result.m_limbs.empty();
+		return result;
 	}
-	sz1 = in1.substr(0, rt);
-	sz2 = in2.substr(0, rt);
-	if (borrow)
+	return divideAsFloatingPoint(*this, other);
+}
+
+BigNumber BigNumber::modulo(const BigNumber& other) const
+{
+	if (empty() || other.empty())
+	{
+		LOG_ERROR("INVALID Operation!");
+		return BigNumber();
+	}
+	if (!isFinite() || !other.isFinite())
+	{
+		return sNAN;
+	}
+	if (other.isZero())
+	{
+		return sDIVIDE_BY_ZERO;
+	}
+
+	// Remainder of the magnitudes on the common scale, sign follows the divisor
+	BigNumber result;
+	result.m_precision = m_precision;
+	result.m_scale = std::max(m_scale, other.m_scale);
+	DoubleLimb num{};
+	DoubleLimb den{};
+	if (nativeMagnitude(result.m_scale, num) && other.nativeMagnitude(result.m_scale, den))
+	{
+		nsLimb::fromDoubleLimb(num % den, result.m_limbs);
+	}
+	else
+	{
+		divideAsIntegers(scaledMagnitude(result.m_scale), other.scaledMagnitude(result.m_scale), result.m_limbs);
+	}
+	result.m_bNegative = other.isNegative();
+	result.trimZeros();
+	return result;
+}
+
+std::pair<BigNumber, BigNumber> BigNumber::divideWithRemainder(const BigNumber& other, const DivisionMode mode) const
+{
+	if (empty() || other.empty())
+	{
+		LOG_ERROR("INVALID Operation!");
+		return std::make_pair(BigNumber(), BigNumber());
+	}
+	if (!isFinite() || !other.isFinite())
+	{
+		return std::make_pair(sNAN, sNAN);
+	}
+	if (other.isZero())
+	{
+		return std::make_pair(sDIVIDE_BY_ZERO, sDIVIDE_BY_ZERO);
+	}
+
+	// |lhs| = quotient * |rhs| + remainder on the common scale, both out of the same division
+	BigNumber quotient;
+	BigNumber remainder;
+	quotient.m_precision = m_precision;
+	remainder.m_precision = m_precision;
+	remainder.m_scale = std::max(m_scale, other.m_scale);
+	LimbVector divisor;
+	DoubleLimb num{};
+	DoubleLimb den{};
+	if (nativeMagnitude(remainder.m_scale, num) && other.nativeMagnitude(remainder.m_scale, den))
+	{
+		nsLimb::fromDoubleLimb(num / den, quotient.m_limbs);
+		nsLimb::fromDoubleLimb(num % den, remainder.m_limbs);
+		nsLimb::fromDoubleLimb(den, divisor);
+	}
+	else
+	{
+		divisor = other.scaledMagnitude(remainder.m_scale);
+		quotient.m_limbs = divideAsIntegers(scaledMagnitude(remainder.m_scale), divisor, remainder.m_limbs);
+	}
+
+	// Floor and euclidean move the quotient one away from zero when the remainder has to flip sign
+	const bool signsDiffer = m_bNegative != other.m_bNegative;
+	if (!remainder.m_limbs.empty() && ((mode == DivisionMode::kFLOOR && signsDiffer) || (mode == DivisionMode::kEUCLIDEAN && m_bNegative)))
+	{
+		const Limb carry = nsLimb::addLimb(quotient.m_limbs.data(), quotient.m_limbs.data(), quotient.m_limbs.size(), 1);
+		if (carry || quotient.m_limbs.empty())
+		{
+			quotient.m_limbs.push_back(1);
+		}
+		remainder.m_limbs = subHelper(divisor, remainder.m_limbs);
+	}
+	quotient.m_bNegative = signsDiffer && !quotient.m_limbs.empty();
+	remainder.m_bNegative = (mode == DivisionMode::kTRUNCATE) ? m_bNegative : (mode == DivisionMode::kFLOOR && other.m_bNegative);
+	remainder.trimZeros();
+	return std::make_pair(quotient, remainder);
+}
+
+BigNumber BigNumber::power(const BigNumber& exp) const
+{
+	if (empty() || exp.empty())
+	{
+		LOG_ERROR("INVALID Operation!");
+		return BigNumber();
+	}
+	if (!isFinite() || !exp.isFinite())
+	{
+		return sNAN;
+	}
+
+	if (isZero())
+	{
+		return exp.m_bNegative ? sNAN : BigNumber("0");
+	}
+	if (isEqual(1))
+	{
+		return BigNumber(1);
+	}
+	if (exp.isEqual(1))
+	{
+		return (*this);
+	}
+	if (exp.isZero())
+	{
+		return BigNumber("1");
+	}
+	if (exp.isFloatingPoint())
+	{
+		return powerHelperFractionalExponent(exp);
+	}
+	if (exp.isNegative())
+	{
+		return divideAsFloatingPoint(BigNumber(1), this->power(-exp));
+	}
+	bool bNegative{ false };
+	if (m_bNegative && !exp.isEven())
+	{
+		bNegative = true;
+	}
+
+	BigNumber base(*this);
+	base.m_bNegative = false;
+
+	BigNumber ans = powerHelperIntegerExponent(base, exp.scaledMagnitude(0));
+	//If n is an even integer, then(−1)n = 1.
+	//If n is an odd integer, then(−1)n = −1.
+	ans.m_bNegative = bNegative && !ans.isZero();
+	return ans;
+}
+
+BigNumber BigNumber::powerModulo(const BigNumber& exp, const BigNumber& modulus) const
+{
+	if (empty() || exp.empty() || modulus.empty())
+	{
+		LOG_ERROR("INVALID Operation!");
+		return BigNumber();
+	}
+	if (!isFinite() || !exp.isFinite() || !modulus.isFinite())
+	{
+		return sNAN;
+	}
+	if (!isInteger() || !exp.isInteger() || !modulus.isInteger() || exp.isNegative() || modulus.isNegative() || modulus.isZero())
+	{
+		LOG_ERROR("Modular power needs integers, a non negative exponent and a positive modulus!");
+		return sNAN;
+	}
+
+	BigNumber result;
+	result.m_precision = m_precision;
+	const LimbVector m = modulus.scaledMagnitude(0);
+	result.m_limbs = nsLimb::powerModulo(scaledMagnitude(0), exp.scaledMagnitude(0), m);
+	// (-a)^e = a^e for even e, m - a^e otherwise
+	if (m_bNegative && exp.isOdd() && !result.m_limbs.empty())
+	{
+		result.m_limbs = subHelper(m, result.m_limbs);
+	}
+	return result;
+}
+
+BigNumber::LimbVector BigNumber::addHelper(const LimbVector &in1, const LimbVector &in2) const
+{
+	const LimbVector& big = in1.size() >= in2.size() ? in1 : in2;
+	const LimbVector& small = in1.size() >= in2.size() ? in2 : in1;
+	LimbVector szAns(big.size() + 1);
+	szAns[big.size()] = nsLimb::add(szAns.data(), big.data(), big.size(), small.data(), small.size());
+	nsLimb::normalize(szAns);
+	return szAns;
+}
+
+// in1 >= in2
+BigNumber::LimbVector BigNumber::subHelper(const LimbVector &in1, const LimbVector &in2) const
+{
+	LimbVector szAns(in1.size());
+	nsLimb::sub(szAns.data(), in1.data(), in1.size(), in2.data(), in2.size());
+	nsLimb::normalize(szAns);
+	return szAns;
+}
+
+BigNumber::LimbVector BigNumber::multiplyHelper(const LimbVector &in1, const LimbVector &in2) const
+{
+	return nsLimb::multiply(in1, in2);
+}
+
+BigNumber::LimbVector BigNumber::squareHelper(const LimbVector &in) const
+{
+	return nsLimb::square(in);
+}
+
+// m_limbs = in1 * in2 rounded from m_scale to m_precision digits, with a short product that leaves out
+// the partial products below the rounding digit. The error it leaves is kept 2^20 times below the
+// rounding unit, false when the rounding still falls within it and needs the whole product.
+bool BigNumber::roundedShortProduct(const LimbVector &in1, const LimbVector &in2)
+{
+	constexpr double kGUARD_BITS = 20.0;
+	if (m_scale <= static_cast<ScaleType>(m_precision))
 	{
-		increment(sz2);
-		borrow = 0;
+		return false;
 	}
-	int cmpVal = compareStringAsNumber(sz1, sz2, false);
-	if (cmpVal > 0)
+	const SizeType digits = static_cast<SizeType>(m_scale) - m_precision;
+	const double errorBits = static_cast<double>(digits) * std::log2(10.0) - kGUARD_BITS;
+	if (errorBits <= 0.0)
 	{
-		str = std::to_string(stoll_s(sz1) - stoll_s(sz2));
+		return false;
 	}
-	else if (cmpVal < 0)
+	const SizeType error = static_cast<SizeType>(errorBits / std::log2(static_cast<double>(nsLimb::kLIMB_BASE)));
+	LimbVector high;
+	SizeType shift{};
+	LimbVector quotient;
+	if (!nsLimb::shortMultiply(in1, in2, error, high, shift) || !nsLimb::roundApproximateByPow10(high, shift, error, digits, quotient))
 	{
-		if (sz1.size() != sz2.size())
-		{
-			makeEqualLength(sz1, sz2);
-		}
-		sz1.insert(0, 1, '1');
-		str = std::to_string(stoll_s(sz1) - stoll_s(sz2));
-		borrow = 1;
+		return false;
 	}
-	szAns.insert(0, str);
-	return szAns;
+	m_limbs.swap(quotient);
+	m_scale = static_cast<ScaleType>(m_precision);
+	return true;
 }
 
-BigNumber::ValueType BigNumber::multiplyHelper(ValueType in1, ValueType in2) const
+BigNumber::LimbVector BigNumber::divideAsIntegers(const LimbVector &numerator, const LimbVector &denominator, LimbVector &remainder) const
 {
-	bool bNegative = false;
-	ValueType szAns;
-	if (in1.size() > 0 && in2.size() > 0)
-	{
-		if (in1[0] == '-')
-		{
-			in1.erase(0, 1);
-			bNegative = true;
-		}
-		if (in2[0] == '-')
+	LimbVector quotient;
+	nsLimb::divideAsIntegers(numerator, denominator, quotient, remainder);
+	return quotient;
+}
+
+BigNumber BigNumber::divideAsFloatingPoint(const BigNumber& numerator, const BigNumber& denominator) const
+{
+	// (n / 10^ns) / (d / 10^ds) = (n * 10^(ds + precision - ns) / d) / 10^precision
+	BigNumber result;
+	result.m_precision = m_precision;
+	result.m_scale = static_cast<ScaleType>(m_precision);
+	result.m_bNegative = numerator.m_bNegative != denominator.m_bNegative;
+
+	DoubleLimb numNative{};
+	DoubleLimb denNative{};
+	const ScaleType shift = denominator.m_scale + static_cast<ScaleType>(m_precision) - numerator.m_scale;
+	const SizeType numShift = shift >= 0 ? static_cast<SizeType>(shift) : 0;
+	const SizeType denShift = shift >= 0 ? 0 : static_cast<SizeType>(-shift);
+	if (nsLimb::toDoubleLimb(numerator.m_limbs, numNative) && nsLimb::multiplyByPow10(numNative, numShift)
+		&& nsLimb::toDoubleLimb(denominator.m_limbs, denNative) && nsLimb::multiplyByPow10(denNative, denShift))
+	{
+		// Half even rounding without doubling the remainder, which could overflow
+		DoubleLimb quotient = numNative / denNative;
+		const DoubleLimb remainder = numNative % denNative;
+		if (remainder > denNative - remainder || (remainder == denNative - remainder && (quotient & 1)))
 		{
-			in2.erase(0, 1);
-			bNegative = !bNegative;
+			quotient++;
 		}
-	}
-	if (in1.empty() || in2.empty())
-	{
-		LOG_ERROR("INVALID Operation!");
-		return szAns;
+		nsLimb::fromDoubleLimb(quotient, result.m_limbs);
+		result.trimZeros();
+		return result;
 	}
 
-	SizeType decimalPos = ValueType::npos;
-	SizeType pos = in1.find_first_of('.');
-	if (pos != ValueType::npos)
-	{
-		in1.erase(pos, 1);
-		decimalPos = in1.size() - pos;
-	}
+	LimbVector num(numerator.m_limbs);
+	LimbVector den(denominator.m_limbs);
+	nsLimb::multiplyByPow10(num, numShift);
+	nsLimb::multiplyByPow10(den, denShift);
 
-	pos = in2.find_first_of('.');
-	if (pos != ValueType::npos)
+	LimbVector remainder;
+	result.m_limbs = divideAsIntegers(num, den, remainder);
+	if (rounder(result.m_limbs, remainder, den))
 	{
-		in2.erase(pos, 1);
-		if (decimalPos == ValueType::npos)
-		{
-			decimalPos = in2.size() - pos;
-		}
-		else
+		const Limb carry = nsLimb::addLimb(result.m_limbs.data(), result.m_limbs.data(), result.m_limbs.size(), 1);
+		if (carry || result.m_limbs.empty())
 		{
-			decimalPos += in2.size() - pos;
+			result.m_limbs.push_back(1);
 		}
 	}
+	result.trimZeros();
+	return result;
+}
 
-	szAns.reserve(in1.size() + in2.size());
-	if (in1.size() > 32 || in2.size() > 32)
-	{
-		szAns = karatsubaMultiplication(in1, in2);
-	}
-	else
+BigNumber BigNumber::powerHelperIntegerExponent(const BigNumber &base, const LimbVector &exp) const
+{
+	if (base.isZero())
 	{
-		szAns = longMultiplication(in1, in2);
+		return BigNumber(0);
 	}
-	trimZeros(szAns);
-	if (decimalPos != ValueType::npos)
+	if (exp.empty())
 	{
-		szAns.insert(szAns.size() - decimalPos, 1, '.');
+		return BigNumber(1);
 	}
-	trimZeros(szAns, true);
-	if (bNegative)
+	if (exp.size() == 1 && exp[0] == 1)
 	{
-		szAns.insert(0, 1, '-');
+		return base;
 	}
-	roundOff(szAns, m_precision);
 
-	if (szAns.find('.') == 0)
+	BigNumber result;
+	result.m_precision = base.m_precision;
+	result.m_bNegative = base.m_bNegative && (exp[0] & 1);
+
+	// A power of ten only moves the decimal point, (10^-s)^e = 10^-(s * e) is held in the scale
+	LimbVector mantissa(base.m_limbs);
+	const SizeType zeros = nsLimb::removeTrailingDecimalZeros(mantissa, base.m_scale > 0 ? 0 : SIZE_MAX);
+	const ScaleType scale = base.m_scale - static_cast<ScaleType>(zeros);
+	DoubleLimb expNative{};
+	const bool nativeExp = nsLimb::toDoubleLimb(exp, expNative) && expNative <= static_cast<DoubleLimb>(LLONG_MAX);
+	ScaleType digits{};
+	if (mantissa.size() == 1 && mantissa[0] == 1 && nativeExp && !__builtin_mul_overflow(scale, static_cast<ScaleType>(expNative), &digits))
 	{
-		szAns.insert(0, 1, '0');
+		if (digits <= static_cast<ScaleType>(result.m_precision))
+		{
+			result.m_limbs = mantissa;
+			result.m_scale = digits;
+		}
+		// else below half of the last kept digit, which rounds to zero
+		result.m_bNegative = result.m_bNegative && !result.m_limbs.empty();
+		return result;
 	}
-	return szAns;
-}
 
-BigNumber::ValueType BigNumber::longMultiplication(ValueType in1, ValueType in2) const
-{
-	ValueType szAns;
-	if (in1.empty() || in2.empty())
+	// Integers are exact, any order of multiplications gives the same value. Zeros held in the scale stay there.
+	if (base.isInteger())
 	{
-		szAns.push_back('0');
-		return szAns;
+		if (base.m_scale < 0 && (!nativeExp || __builtin_mul_overflow(base.m_scale, static_cast<ScaleType>(expNative), &digits)))
+		{
+			LOG_ERROR("Result out of range!");
+			return sINFINITY;
+		}
+		result.m_limbs = nsLimb::power(base.m_limbs, exp);
+		result.m_scale = base.m_scale < 0 ? digits : 0;
+		return result;
 	}
 
-	std::reverse(in1.begin(), in1.end());
-	std::reverse(in2.begin(), in2.end());
-
-	int base = 10;
-
-	SizeType in1Max = in1.size();
-	SizeType in2Max = in2.size();
-
-	szAns.resize(in1Max + in2Max, '0');
-
-	int carry = 0;
-	int num;
-	for (SizeType b_i = 0; b_i < in2Max; ++b_i)
+	// Fractions are rounded after every step, squaring and multiplying along the bits from the top
+	// keeps the rounding of halving the exponent recursively
+	LimbVector words = nsLimb::binaryWords(exp);
+	nsLimb::normalize(words);
+	result = base;
+	for (SizeType i = nsLimb::bitLength(words) - 1; i-- > 0;)
 	{
-		carry = 0;
-		for (SizeType a_i = 0; a_i < in1Max; ++a_i)
+		result = result.square();
+		if ((words[i / nsLimb::kLIMB_BITS] >> (i % nsLimb::kLIMB_BITS)) & 1)
 		{
-			num = to_int(szAns[a_i + b_i]);
-
-			num += carry + to_int(in2[b_i]) * to_int(in1[a_i]);
-			carry = num / base;
-			szAns[a_i + b_i] = to_char(num % base);
+			result = base.multiply(result);
 		}
-		szAns[b_i + in1Max] = to_char(carry);
 	}
-	std::reverse(szAns.begin(), szAns.end());
-	return szAns;
+	return result;
 }
 
-//function karatsuba(num1, num2)
-//if (num1 < 10) or (num2 < 10)
-//	return num1 × num2 /* fall back to traditional multiplication */
-//
-///* Calculates the size of the numbers. */
-//m = min(size_base10(num1), size_base10(num2))
-//m2 = floor(m / 2)
-///* m2 = ceil (m / 2) will also work */
-//
-///* Split the digit sequences in the middle. */
-//high1, low1 = split_at(num1, m2)
-//high2, low2 = split_at(num2, m2)
-//
-///* 3 recursive calls made to numbers approximately half the size. */
-//z0 = karatsuba(low1, low2)
-//z1 = karatsuba(low1 + high1, low2 + high2)
-//z2 = karatsuba(high1, high2)
-//
-//return (z2 × 10 ^ (m2 × 2)) + ((z1 - z2 - z0) × 10 ^ m2) + z0
-
-BigNumber::ValueType BigNumber::karatsubaMultiplication(const ValueType &num1, const ValueType &num2) const
+// x^y = e^(y log x) for x > 0. The result has about y log10(x) digits before the point and y the digits of
+// its integer part, log x carries all of them on top of the precision for the error to stay below the last digit.
+BigNumber BigNumber::powerHelperFractionalExponent(const BigNumber &exp) const
 {
-	if (num1.size() < 8 && num2.size() < 8)
+	if (m_bNegative)
 	{
-		return std::to_string(stoll_s(num1) * stoll_s(num2));
+		LOG_ERROR("Fractional power of a negative number!");
+		return sNAN;
 	}
-	else if (num1.size() < 2 || num2.size() < 2)
+	const double expDigits = exp.log10Estimate();
+	const double digits = (exp.m_bNegative ? -1.0 : 1.0) * std::pow(10.0, expDigits) * log10Estimate();
+	if (digits > kMAX_RESULT_DIGITS)
 	{
-		return longMultiplication(num1, num2);
+		LOG_ERROR("Result out of range!");
+		return sINFINITY;
 	}
 
-	SizeType m2 = (std::min(num1.size(), num2.size())) / 2;
-
-	//split_at("12345", 3) will extract the 3 final digits, giving: high = "12", low = "345".
-
-	ValueType high1;
-	ValueType low1;
-	split_at(num1, m2, high1, low1);
-
-	ValueType high2;
-	ValueType low2;
-	split_at(num2, m2, high2, low2);
-
-	BigNumber z0{ karatsubaMultiplication(low1, low2) };
-	BigNumber z1{ karatsubaMultiplication(addHelper(low1, high1), addHelper(low2, high2)) };
-	BigNumber z2{ karatsubaMultiplication(high1, high2) };
-	//return (z2 × 10 ^ (m2 × 2)) + ((z1 - z2 - z0) × 10 ^ m2) + z0
-	z1 -= z2;
-	z1 -= z0;
-	z2.multiplyBy10(2 * m2);
-	z1.multiplyBy10(m2);
-	return static_cast<ValueType>(z2 + z1 + z0);
+	BigNumber x(*this);
+	x.m_precision = m_precision + kGUARD_DIGITS + static_cast<SizeType>(std::ceil(std::max(digits, 0.0) + std::max(expDigits, 0.0)));
+	BigNumber z = x.logarithm().multiply(exp);
+	z.m_precision = m_precision;
+	return z.exponential();
 }
 
-BigNumber::ValueType BigNumber::divideAsIntegers(ValueType numerator, ValueType denominator, ValueType& remainder) const
+// Correctly rounded x^(1/n): with x = M / 10^s and p digits kept, k = floor((M * 10^(n p - s))^(1/n))
+// is the root without rounding, and it goes up by one when (k + 1/2)^n is not above M * 10^(n p - s)
+BigNumber BigNumber::nthRoot(const uint64_t n) const
 {
-	// if a and b are +ve and b != 0
-	// if a < b, then 0,a
-	// let q = 0
-	// let r = a
-	// repeat
-	//		let q = q + 1
-	//		let r = r - b
-	// until r < b
-	// return q,r
-	numerator = split_at(numerator).first;
-	denominator = split_at(denominator).first;
-	ValueType quotient("0");
-	int cmpVal = compareStringAsNumber(numerator, denominator, false);
-	if (cmpVal < 0)
+	if (empty())
 	{
-		remainder = numerator;
+		LOG_ERROR("INVALID Operation!");
+		return BigNumber();
 	}
-	else if (cmpVal == 0)
+	if (!isFinite())
 	{
-		remainder = "0";
-		quotient = "1";
+		return sNAN;
 	}
-	else if(numerator.size() == denominator.size() || numerator.size() == (1 + denominator.size()))
+	if (n == 0 || n > nsLimb::kLIMB_MAX || (m_bNegative && (n & 1) == 0))
 	{
-		remainder = numerator;
-		do
-		{
-			increment(quotient);
-			remainder = subHelper(remainder, denominator);
-		} while (compareStringAsNumber(remainder, denominator, false) >= 0);
+		LOG_ERROR("Root degree has to be positive, and odd for negative numbers!");
+		return sNAN;
 	}
-	else
+	if (n == 1 || isZero())
 	{
-		quotient.clear();
-		cmpVal = fillUpDstForDivision(remainder, numerator, denominator);
-		while (cmpVal >= 0)
-		{
-			quotient += divideAsIntegers(remainder, denominator, remainder);
-			if (remainder == "0")
-			{
-				remainder.clear();
-			}
-			SizeType zerosToPad = remainder.size();
-			cmpVal = fillUpDstForDivision(remainder, numerator, denominator);
-			zerosToPad = remainder.size() - zerosToPad;
-			if (zerosToPad > 1)
-			{
-				zerosToPad--;
-				quotient.insert(quotient.size(), zerosToPad, '0');
-			}
-		}
+		return *this;
 	}
-	return quotient;
-}
 
-BigNumber::ValueType BigNumber::divideAsFloatingPoint(const ValueType& num1, const ValueType& frac1, const ValueType& num2, const ValueType& frac2) const
-{
-	bool bMultiply{ false };
-	SizeType decimalPos{};
-	if (frac1.size() > frac2.size())
+	SizeType digits{};
+	if (__builtin_mul_overflow(static_cast<SizeType>(n), m_precision, &digits))
 	{
-		decimalPos = frac1.size() - frac2.size();
+		LOG_ERROR("Root degree out of range!");
+		return sNAN;
 	}
-	else if (frac1.size() < frac2.size())
+	// lhs and rhs compare M * 10^(n p - s) against (k + 1/2)^n, both sides scaled to integers
+	LimbVector lhs(m_limbs);
+	LimbVector a;
+	LimbVector fraction;
+	const ScaleType shift = static_cast<ScaleType>(digits) - m_scale;
+	if (shift >= 0)
 	{
-		decimalPos = frac2.size() - frac1.size();
-		bMultiply = true;
+		nsLimb::multiplyByPow10(lhs, static_cast<SizeType>(shift));
+		a = lhs;
 	}
-
-	const ValueType denominator{ num2 + frac2 };
-	ValueType remainder;
-	ValueType szAns = divideAsIntegers(num1 + frac1, denominator, remainder);
-	
-	if (remainder != "0")
+	else
 	{
-		ValueType tempNumerator;
-		ValueType fraction;
-		SizeType denomSize = denominator.size();
-
-		tempNumerator.insert(0, denomSize + 1, '0');
-
-		while (remainder != "0" && fraction.size() < m_precision)
-		{
-			SizeType zerosToPad = remainder.size();
-			fillUpDstForDivision(remainder, tempNumerator, denominator);
-			zerosToPad = remainder.size() - zerosToPad;
-			if (zerosToPad > 1)
-			{
-				zerosToPad--;
-				fraction.insert(fraction.size(), zerosToPad, '0');
-			}
-			fraction += divideAsIntegers(remainder, denominator, remainder);
-			tempNumerator.insert(0, 1 + denomSize - tempNumerator.size(), '0');
-		}
-
-		SizeType pos = fraction.find('.');
-		if (pos != ValueType::npos)
-		{
-			pos = fraction.size() - pos;
-			fraction.erase('.');
-			if (bMultiply)
-			{
-				if (pos > decimalPos)
-				{
-					decimalPos = pos - decimalPos;
-					bMultiply = false;
-				}
-				else
-				{
-					decimalPos = decimalPos - pos;
-				}
-			}
-		}
-		if (szAns == "0")
-		{
-			szAns.clear();
-		}
-		szAns += fraction;
-		if (bMultiply)
-		{
-			if (decimalPos >= fraction.size())
-			{
-				decimalPos -= fraction.size();
-			}
-			else
-			{
-				decimalPos = fraction.size() - decimalPos;
-				bMultiply = false;
-			}
-		}
-		else
-		{
-			decimalPos += fraction.size();
-		}
-
+		nsLimb::divideByPow10(m_limbs, static_cast<SizeType>(-shift), a, fraction);
+	}
 
-		if (!decimalPos)
-		{
-			fraction.insert(0, 1, '.');
-		}
+	LimbVector k = nsLimb::root(a, n);
+	const LimbVector exp{ n };
+	LimbVector twiceK(k.size() + 1);
+	twiceK[k.size()] = nsLimb::mulLimb(twiceK.data(), k.data(), k.size(), 2);
+	nsLimb::addLimb(twiceK.data(), twiceK.data(), twiceK.size(), 1);
+	LimbVector rhs = nsLimb::power(twiceK, exp);
+	lhs = multiplyHelper(lhs, nsLimb::power(LimbVector{ 2 }, exp));
+	if (shift < 0)
+	{
+		nsLimb::multiplyByPow10(rhs, static_cast<SizeType>(-shift));
 	}
-	if (decimalPos)
+	const int cmp = nsLimb::compare(lhs, rhs);
+	if (cmp > 0 || (cmp == 0 && !k.empty() && (k[0] & 1)))
 	{
-		if (bMultiply)
-		{
-			szAns.insert(szAns.size(), decimalPos, '0');
-		}
-		else
+		if (nsLimb::addLimb(k.data(), k.data(), k.size(), 1) || k.empty())
 		{
-			if (szAns.size() < decimalPos)
-			{
-				szAns.insert(0, decimalPos - szAns.size(), '0');
-			}
-			szAns.insert(szAns.size() - decimalPos, 1, '.');
+			k.push_back(1);
 		}
 	}
-	trimZeros(szAns);
-	trimZeros(szAns, true);
-	roundOff(szAns, m_precision);
-	if (szAns.find('.') == 0)
-	{
-		szAns.insert(0, 1, '0');
-	}
-	return szAns;
+
+	BigNumber result;
+	result.m_precision = m_precision;
+	result.m_limbs = k;
+	result.m_scale = static_cast<ScaleType>(m_precision);
+	result.m_bNegative = m_bNegative;
+	result.trimZeros();
+	return result;
 }
 
-BigNumber::ValueType BigNumber::powerHelperIntegerExponent(const ValueType &base, const ValueType &exp) const
+// e^x rounded to m_precision digits. With x = r * 2^s and r < 1, e^r is the product of e^piece over the
+// pieces of r with fraction digits (0, 1], (1, 2], (2, 4], (4, 8] ..., each series summed by binary splitting,
+// then squared s times. A piece ending at digit 2^j is below 10^-2^(j-1), its series needs fewer terms just as
+// fast as the terms grow, so every piece costs about one multiplication at the working precision.
+BigNumber BigNumber::exponential() const
 {
-	if (base == "0")
+	if (empty())
 	{
-		return "0";
+		LOG_ERROR("INVALID Operation!");
+		return BigNumber();
 	}
-	if (exp == "0")
+	if (!isFinite())
 	{
-		return "1";
+		return sNAN;
 	}
-	if (exp == "1")
+
+	BigNumber result;
+	result.m_precision = m_precision;
+	if (isZero())
 	{
-		return base;
+		result.m_limbs.push_back(1);
+		return result;
 	}
 
-	ValueType rem;
-	const ValueType halfPower = powerHelperIntegerExponent(base, divideAsIntegers(exp, "2", rem));
-	if (isEven(exp))
+	// x and log10(e^x) in floating point
+	const double estimate = (m_bNegative ? -1.0 : 1.0) * std::pow(10.0, log10Estimate());
+	const double digits = estimate / std::log(10.0);
+	if (digits < -static_cast<double>(m_precision) - 1.0)
 	{
-		return multiplyHelper(halfPower, halfPower);
+		// Below a tenth of the last kept digit
+		return result;
 	}
-	else
+	if (digits > kMAX_RESULT_DIGITS)
 	{
-		if (compareStringAsNumber(exp, "0", false) > 0)
-		{
-			return multiplyHelper(base, multiplyHelper(halfPower, halfPower));
-		}
-		else
-		{
-			const std::pair<ValueType, ValueType> p1{ split_at(multiplyHelper(halfPower, halfPower)) };
-			const std::pair<ValueType, ValueType> p2{ split_at(base) };
-			return divideAsFloatingPoint(p1.first, p1.second, p2.first, p2.second);
-		}
+		LOG_ERROR("Result out of range!");
+		return sINFINITY;
 	}
-}
-
-/*From geeksforgeeks
-* double nthRoot(int A, int N)
-*{
-*	// initially guessing a random number between 0 and 9
-*	double xPre = 1;// rand() % 10;
-*	//  smaller eps, denotes more accuracy
-*	double eps = 1e-3;
-*	// initializing difference between two roots by INT_MAX
-*	double delX = INT_MAX;
-*	//  xK denotes current value of x
-*	double xK;
-*	//  loop until we reach desired accuracy
-*	while (delX > eps)
-*	{
-*		//  calculating current value from previous
-*		// value by newton's method
-*		xK = ((N - 1.0) * xPre + (double)A / pow(xPre, N - 1)) / (double)N;
-*		delX = abs(xK - xPre);
-*		xPre = xK;
-*	}
-*	return xK;
-*}
-*/
-BigNumber::ValueType BigNumber::nth_Root(const ValueType &num, const ValueType &fraction) const
-{
-	ValueType xPre{ std::to_string(rand() % 10) };
 
-	const ValueType eps{ "0.0010000000000000" };
+	// Every squaring doubles the relative error, digits before the point need to be right too
+	const SizeType halvings = std::fabs(estimate) >= 0.5 ? static_cast<SizeType>(std::log2(std::fabs(estimate))) + 2 : 0;
+	const SizeType working = m_precision + kGUARD_DIGITS + static_cast<SizeType>(std::ceil(static_cast<double>(halvings) * std::log10(2.0) + std::max(digits, 0.0)));
 
-	ValueType delX{ std::to_string(INT_MAX) };
-	
-	ValueType xK;
-
-	const ValueType n_minus_1{ subHelper(divideAsFloatingPoint("1", "", "", fraction), "1")};
-	const std::pair<ValueType, ValueType> numPair = split_at(num);
+	// r = |x| / 2^s exactly, M / 10^scale / 2^s = M * 5^s / 10^(scale + s), cut to the working precision
+	LimbVector r(m_limbs);
+	nsLimb::multiplyByPower(r, 5, halvings);
+	const ScaleType rScale = m_scale + static_cast<ScaleType>(halvings);
+	if (rScale < 0)
+	{
+		nsLimb::multiplyByPow10(r, static_cast<SizeType>(-rScale));
+	}
+	SizeType fractionDigits = rScale > 0 ? static_cast<SizeType>(rScale) : 0;
+	if (fractionDigits > working)
+	{
+		LimbVector truncated;
+		LimbVector remainder;
+		nsLimb::divideByPow10(r, fractionDigits - working, truncated, remainder);
+		r.swap(truncated);
+		fractionDigits = working;
+	}
 
-	const ValueType frac{ "0." + fraction };
-	std::pair<ValueType, ValueType> p;
-	int counter = 0;
-	while (compareStringAsNumber(delX, eps) > 0 && counter++ < 20)
+	// Pieces from the last digits up, each is u / 10^high with u below 10^(high - low)
+	BigNumber product(1);
+	product.m_precision = working;
+	for (SizeType high = fractionDigits; high > 0;)
 	{
-		p = split_at(powerHelperIntegerExponent(xPre, n_minus_1));
-		ValueType b1{ multiplyHelper(n_minus_1, xPre) };
-		ValueType b2{ divideAsFloatingPoint(numPair.first, numPair.second, p.first, p.second) };
-		ValueType c = addHelper(b1, b2);
-		xK = multiplyHelper(c, frac);
-		if (compareStringAsNumber(xK, xPre) > 0)
+		SizeType low = high > 1 ? 1 : 0;
+		while (low && 2 * low < high)
 		{
-			delX = subHelper(xK, xPre);
+			low *= 2;
 		}
-		else
+		LimbVector rest;
+		LimbVector piece;
+		nsLimb::divideByPow10(r, high - low, rest, piece);
+		if (!piece.empty())
 		{
-			delX = subHelper(xPre, xK);
+			product = product.multiply(exponentialSeries(piece, high, working));
 		}
-		printf("p = %s, b1 = %s, b2 = %s, c = %s, xk = %s, xPre = %s, delX = %s\n", (p.first + "." + p.second).c_str(), b1.c_str(), b2.c_str(), c.c_str(), xK.c_str(), xPre.c_str(), delX.c_str());
-		xPre = xK;
-	}
-	return xK;
-}
-
-void BigNumber::multiplyBy10(uint64_t times)
-{
-	if (m_szFraction.size() > times)
-	{
-		m_szNumber.insert(m_szNumber.size(), m_szFraction.substr(0, times));
-		m_szFraction.erase(0, times);
-		trimZeros(m_szFraction, true);
+		r.swap(rest);
+		high = low;
 	}
-	else if (m_szFraction.size() == times)
+	for (SizeType i = 0; i < halvings; ++i)
 	{
-		m_szNumber += m_szFraction;
-		m_szFraction.clear();
+		product = product.square();
 	}
-	else
+
+	if (m_bNegative)
 	{
-		m_szNumber += m_szFraction;
-		times -= m_szFraction.size();
-		m_szNumber.insert(m_szNumber.size(), times, '0');
-		m_szFraction.clear();
+		return result.divideAsFloatingPoint(BigNumber(1), product);
 	}
-	trimZeros(m_szNumber);
+	product.m_precision = m_precision;
+	product.roundOff(m_precision);
+	product.trimZeros();
+	return product;
 }
 
-void BigNumber::divideBy10(uint64_t times)
+// Natural logarithm rounded to m_precision digits, x = m * 10^e with 1 <= m < 10 gives log x = log m + e log 10
+BigNumber BigNumber::logarithm() const
 {
-	if (m_szNumber.size() > times)
+	if (empty())
 	{
-		m_szFraction.insert(0, m_szNumber.substr(m_szNumber.size() - times));
-		m_szNumber.erase(m_szNumber.size() - times, times);
-		trimZeros(m_szNumber);
+		LOG_ERROR("INVALID Operation!");
+		return BigNumber();
 	}
-	else if (m_szNumber.size() == times)
+	if (!isFinite())
 	{
-		m_szFraction.insert(0, m_szNumber);
-		m_szNumber = "0";
+		return sNAN;
 	}
-	else
+	if (isZero() || m_bNegative)
 	{
-		m_szFraction.insert(0, m_szNumber);
-		times -= m_szNumber.size();
-		m_szFraction.insert(0, times, '0');
-		m_szNumber = "0";
+		LOG_ERROR("Logarithm of a number that is not positive!");
+		return sNAN;
 	}
-	trimZeros(m_szFraction, true);
-	roundOff(m_szNumber, m_szFraction, m_precision);
+
+	const SizeType working = m_precision + kGUARD_DIGITS;
+	const SizeType digits = nsLimb::decimalDigitCount(m_limbs);
+	const int64_t exponent = static_cast<int64_t>(digits - 1) - m_scale;
+	BigNumber mantissa;
+	mantissa.m_limbs = m_limbs;
+	mantissa.m_scale = static_cast<ScaleType>(digits - 1);
+	mantissa.m_precision = working;
+	mantissa.roundOff(working);
+	mantissa.trimZeros();
+
+	BigNumber result = logarithmNewton(mantissa, working);
+	if (exponent != 0)
+	{
+		// e log 10 needs as many more digits as e has
+		BigNumber shift = constant(Constant::kLN10, working + std::to_string(std::llabs(exponent)).size());
+		shift = shift.multiply(BigNumber(exponent));
+		result = shift.add(result);
+	}
+	result.m_precision = m_precision;
+	result.roundOff(m_precision);
+	result.trimZeros();
+	return result;
 }
 
-void BigNumber::increment()
+// log10(x) = log(x) / log(10), a power of ten comes out exact since the error stays far below the last digit
+BigNumber BigNumber::logarithm10() const
 {
-	if (m_bNegative)
-	{
-		decrement(m_szNumber);
-		trimZeros(m_szNumber);
-		if (isEqual(0))
-		{
-			m_bNegative = false;
-		}
-	}
-	else
+	if (empty() || !isFinite() || isZero() || m_bNegative)
 	{
-		increment(m_szNumber);
+		return logarithm();
 	}
+
+	// The quotient has as many digits before the point as log10(log10(x)), which log 10 has to carry too
+	const SizeType working = m_precision + kGUARD_DIGITS + static_cast<SizeType>(std::log10(std::fabs(log10Estimate()) + 1.0)) + 1;
+	BigNumber x(*this);
+	x.m_precision = working;
+	BigNumber result;
+	result.m_precision = m_precision;
+	return result.divideAsFloatingPoint(x.logarithm(), constant(Constant::kLN10, working));
 }
 
-void BigNumber::decrement()
+// e^(u / 10^digits) to precision digits for u / 10^digits < 1, the series 1 + T / Q comes from binary splitting
+BigNumber BigNumber::exponentialSeries(const LimbVector& u, const SizeType digits, const SizeType precision)
 {
-	if (m_bNegative)
+	// Terms u^k / (k! 10^(digits k)) are summed while above 10^-(precision + 2), the rest adds less than that
+	const double logValue = nsLimb::log2Estimate(u) * std::log10(2.0) - static_cast<double>(digits);
+	const double logLimit = -static_cast<double>(precision) - 2.0;
+	SizeType terms = 0;
+	for (double logTerm = logValue; logTerm >= logLimit; logTerm += logValue - std::log10(static_cast<double>(terms + 1)))
 	{
-		increment(m_szNumber);
+		terms++;
 	}
-	else
+
+	BigNumber result;
+	result.m_precision = precision;
+	if (terms == 0)
 	{
-		if (isEqual(0))
-		{
-			m_bNegative = true;
-		}
-		decrement(m_szNumber);
-		trimZeros(m_szNumber);
+		result.m_limbs.push_back(1);
+		return result;
 	}
+	const nsLimb::SeriesSplit split = nsLimb::expSplit(u, digits, 1, terms + 1);
+	BigNumber numerator;
+	numerator.m_limbs = result.addHelper(split.Q, split.T);
+	BigNumber denominator;
+	denominator.m_limbs = split.Q;
+	return result.divideAsFloatingPoint(numerator, denominator);
 }
 
-void BigNumber::increment(ValueType& str) const
+// log(a) for a > 0 with few digits before the point. Halley's iteration y = y + 2 (a - e^y) / (a + e^y)
+// triples the correct digits, the steps run at a third of the precision of the next one and together
+// cost about one and a half exponentials at the full precision.
+BigNumber BigNumber::logarithmNewton(const BigNumber& a, const SizeType precision)
 {
-	int carry = 1;
-	for (SizeType i = str.size(); i-- && carry;)
+	// Step precisions from the last one down to what a start value from a double is good for
+	std::vector<SizeType> steps{ precision };
+	while (steps.back() > 45)
 	{
-		if (str[i] < '9' && str[i] >= '0')
-		{
-			str[i]++;
-			carry = 0;
-		}
-		else
-		{
-			str[i] = '0';
-		}
+		steps.push_back(steps.back() / 3 + 1);
 	}
-	if (carry)
+
+	BigNumber value(a);
+	value.m_precision = precision;
+	BigNumber y;
+	y.m_precision = 17;
+	y.assignNative(std::log(10.0) * a.log10Estimate());
+	for (auto step = steps.rbegin(); step != steps.rend(); ++step)
 	{
-		str.insert(0, 1, to_char(carry));
+		y.m_precision = *step;
+		const BigNumber e = y.exponential();
+		const BigNumber correction = y.divideAsFloatingPoint(value.add(-e), value.add(e));
+		y = y.add(correction.add(correction));
 	}
+	return y;
+}
+
+// atanh(1 / x) = (1 / x) (1 + T / Q), term k is term k - 1 times (2k - 1) / ((2k + 1) x^2)
+BigNumber BigNumber::inverseArctanh(const Limb x, const SizeType precision)
+{
+	// Terms fall by x^2, enough of them to get below 10^-(precision + 2)
+	const SizeType terms = static_cast<SizeType>(static_cast<double>(precision + 2) / (2.0 * std::log10(static_cast<double>(x)))) + 1;
+	const auto leaf = [x](const SizeType k, nsLimb::SeriesSplit& split)
+	{
+		split.P = LimbVector{ static_cast<Limb>(2 * k - 1) };
+		split.Q = LimbVector{ static_cast<Limb>(2 * k + 1) };
+		split.Q.push_back(nsLimb::mulLimb(split.Q.data(), split.Q.data(), 1, x));
+		split.Q.push_back(nsLimb::mulLimb(split.Q.data(), split.Q.data(), 2, x));
+		nsLimb::normalize(split.Q);
+		split.T = split.P;
+	};
+	const nsLimb::SeriesSplit split = nsLimb::binarySplit(leaf, 1, terms + 1, false, nsLimb::seriesThreads());
+
+	BigNumber result;
+	result.m_precision = precision;
+	BigNumber numerator;
+	numerator.m_limbs = result.addHelper(split.Q, split.T);
+	BigNumber denominator;
+	denominator.m_limbs = split.Q;
+	denominator.m_limbs.push_back(nsLimb::mulLimb(denominator.m_limbs.data(), denominator.m_limbs.data(), denominator.m_limbs.size(), x));
+	nsLimb::normalize(denominator.m_limbs);
+	return result.divideAsFloatingPoint(numerator, denominator);
 }
 
-void BigNumber::decrement(ValueType& str) const
+// A constant is computed with guard digits and kept, later requests for at most as many digits
+// only round it, and a precision that was asked for before is a copy
+BigNumber BigNumber::constant(const Constant id, const SizeType precision)
 {
-	if (str.size() == 1 && str[0] == '0')
+	// The most precise value computed so far, and the last one rounded from it so that repeated
+	// calls at one precision skip the rounding. Nothing else is kept, whatever precisions come.
+	struct Entry
 	{
-		str[0] = '1';
-		return;
-	}
-	int carry = 1;
-	for (SizeType i = str.size(); i-- && carry;)
+		BigNumber	working;
+		BigNumber	rounded;
+	};
+	static std::mutex mutex;
+	static std::array<Entry, static_cast<SizeType>(Constant::kCOUNT)> cache;
+
+	Entry& entry = cache[static_cast<SizeType>(id)];
+	BigNumber value;
 	{
-		if (str[i] <= '9' && str[i] > '0')
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!entry.rounded.m_limbs.empty() && entry.rounded.m_precision == precision)
 		{
-			str[i]--;
-			carry = 0;
+			return entry.rounded;
 		}
-		else
+		if (!entry.working.m_limbs.empty() && entry.working.m_precision >= precision + kGUARD_DIGITS)
 		{
-			str[i] = '9';
+			value = entry.working;
 		}
 	}
+	if (value.m_limbs.empty())
+	{
+		// Computed without the lock, two threads asking at once only repeat the work
+		value = computeConstant(id, precision + kGUARD_DIGITS);
+		std::lock_guard<std::mutex> lock(mutex);
+		if (entry.working.m_limbs.empty() || entry.working.m_precision < value.m_precision)
+		{
+			entry.working = value;
+		}
+	}
+
+	value.m_precision = precision;
+	value.roundOff(precision);
+	value.trimZeros();
+	std::lock_guard<std::mutex> lock(mutex);
+	entry.rounded = value;
+	return value;
 }
 
-bool BigNumber::isEven(const ValueType& str, const bool isFractionPart) const
+// Series summed by binary splitting for pi, e and the logarithms, a newton root for sqrt(2)
+BigNumber BigNumber::computeConstant(const Constant id, const SizeType precision)
 {
-	if (str.empty())
+	BigNumber result;
+	result.m_precision = precision;
+	switch (id)
 	{
-		return false;
-	}
-
-	SizeType i = str.size() - 1;
-	if (isFractionPart)
+	case Constant::kPI:
 	{
-		while (str[i] == '0')
+		// Chudnovsky, pi = 426880 sqrt(10005) Q / (13591409 Q + T) with term k the one before times
+		// -(6k - 5)(2k - 1)(6k - 1) / (k^3 640320^3 / 24) and a(k) = 13591409 + 545140134 k, 14 digits a term
+		constexpr Limb kC3_OVER_24 = 10939058860032000ULL;
+		const SizeType terms = static_cast<SizeType>(static_cast<double>(precision) / 14.18) + 2;
+		const auto leaf = [](const SizeType k, nsLimb::SeriesSplit& split)
 		{
-			i--;
-		}
+			const auto product = [](std::initializer_list<Limb> factors)
+			{
+				LimbVector r{ 1 };
+				for (const Limb factor : factors)
+				{
+					r.push_back(nsLimb::mulLimb(r.data(), r.data(), r.size(), factor));
+					nsLimb::normalize(r);
+				}
+				return r;
+			};
+			split.P = product({ static_cast<Limb>(6 * k - 5), static_cast<Limb>(2 * k - 1), static_cast<Limb>(6 * k - 1) });
+			split.Q = product({ static_cast<Limb>(k), static_cast<Limb>(k), static_cast<Limb>(k), kC3_OVER_24 });
+			split.T = split.P;
+			split.T.push_back(nsLimb::mulLimb(split.T.data(), split.T.data(), split.T.size(), static_cast<Limb>(13591409 + 545140134 * k)));
+			nsLimb::normalize(split.T);
+			split.negativeP = true;
+			split.negativeT = true;
+		};
+		const nsLimb::SeriesSplit split = nsLimb::binarySplit(leaf, 1, terms, false, nsLimb::seriesThreads());
+
+		BigNumber numerator;
+		numerator.m_limbs = split.Q;
+		numerator.m_limbs.push_back(nsLimb::mulLimb(numerator.m_limbs.data(), numerator.m_limbs.data(), numerator.m_limbs.size(), 426880));
+		nsLimb::normalize(numerator.m_limbs);
+		BigNumber denominator;
+		denominator.m_limbs = split.Q;
+		denominator.m_limbs.push_back(nsLimb::mulLimb(denominator.m_limbs.data(), denominator.m_limbs.data(), denominator.m_limbs.size(), 13591409));
+		nsLimb::normalize(denominator.m_limbs);
+		BigNumber t;
+		t.m_limbs = split.T;
+		t.m_bNegative = split.negativeT;
+
+		// Q ends in thousands of decimal zeros, dividing first keeps them out of the rounded product
+		BigNumber root(10005);
+		root.m_precision = precision;
+		result = result.divideAsFloatingPoint(numerator, denominator.add(t));
+		return result.multiply(root.nthRoot(2));
+	}
+	case Constant::kE:
+		return exponentialSeries(LimbVector{ 1 }, 0, precision);
+	case Constant::kLN2:
+		// log 2 = 18 atanh(1/26) - 2 atanh(1/4801) + 8 atanh(1/8749)
+		result = inverseArctanh(26, precision + 2) * 18;
+		result -= inverseArctanh(4801, precision + 2) * 2;
+		result += inverseArctanh(8749, precision + 2) * 8;
+		break;
+	case Constant::kLN10:
+		// log 10 = 46 atanh(1/31) + 34 atanh(1/49) + 20 atanh(1/161)
+		result = inverseArctanh(31, precision + 2) * 46;
+		result += inverseArctanh(49, precision + 2) * 34;
+		result += inverseArctanh(161, precision + 2) * 20;
+		break;
+	case Constant::kSQRT2:
+	{
+		BigNumber two(2);
+		two.m_precision = precision;
+		return two.nthRoot(2);
+	}
+	default:
+		LOG_ERROR("Unknown constant!");
+		return sNAN;
 	}
-	static const ValueType evenNums = "02468";
-	return std::isdigit(str[i]) && (evenNums.find(str[i]) != ValueType::npos);
+	result.m_precision = precision;
+	result.roundOff(precision);
+	result.trimZeros();
+	return result;
 }
 
-void BigNumber::split_at(const ValueType str, const SizeType digitCountInLow, ValueType& high, ValueType& low) const
+// log10 of the magnitude in floating point, the value is non zero
+double BigNumber::log10Estimate() const
 {
-	high = str.substr(0, str.size() - digitCountInLow);
-	low = str.substr(str.size() - digitCountInLow);
+	return nsLimb::log2Estimate(m_limbs) * std::log10(2.0) - static_cast<double>(m_scale);
 }
 
-std::pair<BigNumber::ValueType, BigNumber::ValueType> BigNumber::split_at(const ValueType& str, const CharType delimeter) const
+std::pair<BigNumber, BigNumber> BigNumber::integerSquareRoot() const
 {
-	const SizeType pos = str.find(delimeter);
-	if (pos != ValueType::npos)
+	if (empty())
+	{
+		LOG_ERROR("INVALID Operation!");
+		return std::make_pair(BigNumber(), BigNumber());
+	}
+	if (!isFinite() || !isInteger() || m_bNegative)
 	{
-		return std::make_pair(str.substr(0, pos), str.substr(pos + 1));
+		LOG_ERROR("Integer square root needs a non negative integer!");
+		return std::make_pair(sNAN, sNAN);
 	}
-	return std::make_pair(str, "");
+	BigNumber root;
+	BigNumber remainder;
+	root.m_precision = remainder.m_precision = m_precision;
+	root.m_limbs = nsLimb::sqrtRem(scaledMagnitude(0), remainder.m_limbs);
+	return std::make_pair(root, remainder);
 }
 
-void BigNumber::makeEqualLength(ValueType& str1, ValueType& str2, const bool isFractionPart) const
+bool BigNumber::isPerfectSquare() const
 {
-	ValueType& small = str1.size() < str2.size() ? str1 : str2;
-	ValueType& big = (small == str1) ? str2 : str1;
-	if (isFractionPart)
+	if (!isFinite() || !isInteger() || m_bNegative)
 	{
-		small.insert(small.size(), big.size() - small.size(), '0');
-		return;
+		return false;
 	}
-	small.insert(0, big.size() - small.size(), '0');
+	const LimbVector a = scaledMagnitude(0);
+	return nsLimb::maybeSquare(a) && nsLimb::compare(nsLimb::square(nsLimb::root(a, 2)), a) == 0;
 }
 
-void BigNumber::trimZeros(ValueType& str, const bool isFractionPart) const
+bool BigNumber::isPerfectPower() const
 {
-	if (isFractionPart)
+	if (!isFinite() || !isInteger())
 	{
-		str.erase(str.find_last_not_of('0') + 1, ValueType::npos);
-		if (!str.empty() && str.back() == '.')
-		{
-			str.pop_back();
-		}
-		return;
+		return false;
 	}
-	str.erase(0, std::min(str.find_first_not_of('0'), str.size() - 1));
+	return nsLimb::isPerfectPower(scaledMagnitude(0), m_bNegative);
 }
 
-int BigNumber::compareStringAsNumber(const ValueType& str1, const ValueType& str2, const bool isFractionPart) const
+// Only the scale moves, the limbs are left alone
+void BigNumber::multiplyBy10(uint64_t times)
 {
-	//0		if strings are equal
-	//> 0	if the first non - matching character in str1 is greater(in ASCII) than that of str2.
-	//< 0	if the first non - matching character in str1 is lower(in ASCII) than that of str2.
-	// Should not contain leading or trailing zeros, trim before calling
-	if (!isFractionPart)
+	if (isFinite() && !m_limbs.empty())
 	{
-		if (str1[0] == '-' && str2[0] != '-')
-		{
-			return -1;
-		}
-		else if (str1[0] != '-' && str2[0] == '-')
-		{
-			return 1;
-		}
-		else if (str1[0] == '-' && str2[0] == '-')
-		{
-			return compareStringAsNumber(str1.substr(1), str2.substr(1), isFractionPart);
-		}
-		else if (str1 == "0" && str2.empty() || str1.empty() && str2 == "0")
-		{
-			return 0;
-		}
-		else if (str1.size() < str2.size())
-		{
-			return -1;
-		}
-		else if (str1.size() > str2.size())
-		{
-			return 1;
-		}
-		return strcmp(str1.c_str(), str2.c_str());
+		m_scale -= static_cast<ScaleType>(times);
 	}
-	return strcmp(str1.c_str(), str2.c_str());
 }
 
-int BigNumber::compareStringAsNumber(const ValueType& str1, const ValueType& str2) const
+// Only the scale moves, then whatever lands in the fraction is rounded to m_precision digits and trimmed
+void BigNumber::divideBy10(uint64_t times)
 {
-	const std::pair<ValueType, ValueType> p1 = split_at(str1);
-	const std::pair<ValueType, ValueType> p2 = split_at(str2);
-	int cmpVal = compareStringAsNumber(p1.first, p2.first, false);
-	if (cmpVal == 0)
+	if (!isFinite() || m_limbs.empty())
 	{
-		cmpVal = compareStringAsNumber(p1.second, p2.second, true);
+		return;
 	}
-	return cmpVal;
+	m_scale += static_cast<ScaleType>(times);
+	roundOff(m_precision);
+	trimZeros();
 }
 
-int BigNumber::fillUpDstForDivision(ValueType& dst, ValueType& numerator, const ValueType& denominator) const
+void BigNumber::increment()
 {
-	if (numerator.empty())
-	{
-		return -1;
-	}
-	if (dst == "0")
+	if (!isFinite() || m_scale != 0)
 	{
-		dst.clear();
+		(*this) = add(BigNumber(1));
+		return;
 	}
-	SizeType insertCount = dst.size();
-	if (insertCount < denominator.size())
+	if (m_bNegative)
 	{
-		insertCount = denominator.size() - insertCount;
-		dst.insert(dst.size(), numerator.substr(0, insertCount));
-		numerator.erase(0, insertCount);
+		nsLimb::subLimb(m_limbs.data(), m_limbs.data(), m_limbs.size(), 1);
+		nsLimb::normalize(m_limbs);
+		m_bNegative = !m_limbs.empty();
 	}
-	int cmpVal = compareStringAsNumber(dst, denominator, false);
-	while (cmpVal < 0 && !numerator.empty())
+	else if (nsLimb::addLimb(m_limbs.data(), m_limbs.data(), m_limbs.size(), 1))
 	{
-		dst.push_back(numerator.front());
-		numerator.erase(0, 1);
-		cmpVal = compareStringAsNumber(dst, denominator, false);
+		m_limbs.push_back(1);
 	}
-	return cmpVal;
 }
 
-void BigNumber::roundOff(ValueType& num, ValueType& frac, const SizeType precision) const
+void BigNumber::decrement()
 {
-	if (precision == 0)
+	if (!isFinite() || m_scale != 0)
 	{
-		frac.clear();
+		(*this) = add(BigNumber(-1));
+		return;
 	}
-	else if (frac.size() > precision)
+	if (m_bNegative || m_limbs.empty())
 	{
-		printf("Sent For Rounding = %s.%s\n", num.c_str(), frac.c_str());
-		int carry = rounder(frac, 0, precision);
-		while (carry--)
+		m_bNegative = true;
+		if (nsLimb::addLimb(m_limbs.data(), m_limbs.data(), m_limbs.size(), 1))
 		{
-			increment(num);
+			m_limbs.push_back(1);
 		}
-		printf("Out From Rounding = %s.%s\n\n", num.c_str(), frac.c_str());
 	}
+	else
+	{
+		nsLimb::subLimb(m_limbs.data(), m_limbs.data(), m_limbs.size(), 1);
+		nsLimb::normalize(m_limbs);
+	}
+}
+
+// Magnitude expressed with 'scale' fraction digits, scale >= m_scale. Integers get the zeros held in
+// their scale with scale 0.
+BigNumber::LimbVector BigNumber::scaledMagnitude(const ScaleType scale) const
+{
+	LimbVector szAns(m_limbs);
+	nsLimb::multiplyByPow10(szAns, static_cast<SizeType>(scale - m_scale));
+	return szAns;
+}
+
+// Same as scaledMagnitude but as a native 128 bit value, false when it does not fit
+bool BigNumber::nativeMagnitude(const ScaleType scale, DoubleLimb& val) const
+{
+	return nsLimb::toDoubleLimb(m_limbs, val) && nsLimb::multiplyByPow10(val, static_cast<SizeType>(scale - m_scale));
 }
 
-void BigNumber::roundOff(ValueType& number, const SizeType precision) const
+void BigNumber::trimZeros()
 {
-	SizeType pos = number.find('.');
-	if (pos == ValueType::npos)
+	m_scale -= static_cast<ScaleType>(nsLimb::removeTrailingDecimalZeros(m_limbs, fractionDigits()));
+	if (m_limbs.empty())
 	{
-		return;
+		m_scale = 0;
+		m_bNegative = false;
 	}
-	if (precision == 0)
+}
+
+void BigNumber::roundOff(const SizeType precision)
+{
+	if (m_scale <= static_cast<ScaleType>(precision))
 	{
-		number.erase(pos);
 		return;
 	}
-	if ((number.size() - pos - 1) > precision)
+	const SizeType digits = static_cast<SizeType>(m_scale) - precision;
+	LimbVector quotient;
+	LimbVector remainder;
+	nsLimb::divideByPow10(m_limbs, digits, quotient, remainder);
+	if (rounder(quotient, remainder, nsLimb::pow10(digits)))
 	{
-		printf("Sent For Rounding = %s\n", number.c_str());
-		int carry = rounder(number, pos + 1, precision);
-		if (carry > 0)
+		if (nsLimb::addLimb(quotient.data(), quotient.data(), quotient.size(), 1) || quotient.empty())
 		{
-			number = addHelper(number, std::to_string(carry));
+			quotient.push_back(1);
 		}
-		printf("Out From Rounding = %s\n\n", number.c_str());
 	}
+	m_limbs.swap(quotient);
+	m_scale = static_cast<ScaleType>(precision);
 }
 
-int BigNumber::rounder(ValueType& str, const SizeType pos, const SizeType precision) const
+// Returns 1 when quotient has to be rounded away from zero for the given remainder and divisor
+// Banker's rounding / odd-even rounding on a tie
+int BigNumber::rounder(const LimbVector& quotient, const LimbVector& remainder, const LimbVector& divisor) const
 {
-	static const ValueType down{ "01234" };
-	static const ValueType up{ "6789" };
-
-	static const ValueType odd{ "13579" };
-
-	const CharType ch = str[pos + precision];
-	int carry = 0;
-
-	if (down.find(ch) != ValueType::npos)
-	{
-		// No changes to the ULP [unit at last position]
-		carry = 0;
-	}
-	else if (up.find(ch) != ValueType::npos)
+	if (remainder.empty())
 	{
-		carry = 1;	
-	}
-	else
-	{
-		// If digit is 5
-		// Banker's rounding / odd-even rounding
-		const CharType prevChar = str[pos + precision - 1];
-		if (odd.find(prevChar) != ValueType::npos)
-		{
-			carry = 1;
-		}
+		return 0;
 	}
-
-	str.erase(pos + precision);
-	for (SizeType i = str.size(); i-- && str[i] != '.' && carry ;)
+	LimbVector twice(remainder.size() + 1);
+	twice[remainder.size()] = nsLimb::add(twice.data(), remainder.data(), remainder.size(), remainder.data(), remainder.size());
+	const int cmpVal = nsLimb::compare(twice, divisor);
+	if (cmpVal == 0)
 	{
-		if (str[i] < '9')
-		{
-			str[i]++;
-			carry = 0;
-		}
-		else
-		{
-			str[i] = '0';
-		}
+		return (!quotient.empty() && (quotient[0] & 1)) ? 1 : 0;
 	}
-	return carry;
+	return cmpVal > 0 ? 1 : 0;
 }
 }
-#endif	// #ifndef __BIGNUMBER_H__
\ No newline at end of file
+#endif // #ifndef __BIGNUMBER_H__
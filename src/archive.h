@@ -0,0 +1,293 @@
+/*
+	@file	: archive.h
+	@breif	: File of many serialized BigNumbers, memory mapped and indexed by position
+
+	@NOTE	: A 32 byte header, the records of serialize packed one after the other, then an index
+			  of (count + 1) little-endian 8 byte offsets, record i spans [offset i, offset i + 1):
+				bytes  0 -  3 : magic "BNAR"
+				byte   4      : format version
+				bytes  5 -  7 : zero
+				bytes  8 - 15 : record count
+				bytes 16 - 23 : index offset
+				bytes 24 - 31 : zero
+			  The reader maps the file read only, item i is two index reads and a view on the record,
+			  so opening costs nothing per record and only the pages touched are ever loaded.
+*/
+
+#ifndef __ARCHIVE_H__
+#define __ARCHIVE_H__
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "serialization.h"
+
+namespace nsNumber
+{
+namespace nsSerial
+{
+constexpr unsigned char kARCHIVE_MAGIC[4] = { 'B', 'N', 'A', 'R' };
+constexpr uint8_t kARCHIVE_VERSION = 1;
+constexpr size_t kARCHIVE_HEADER_SIZE = 32;
+}	// namespace nsSerial
+
+// Writes an archive record by record, the index and the header go out on close
+class ArchiveWriter
+{
+	using SizeType = size_t;
+public:
+	inline explicit ArchiveWriter(const std::string& path);
+	~ArchiveWriter() { close(); }
+
+	ArchiveWriter(const ArchiveWriter&) = delete;
+	ArchiveWriter& operator=(const ArchiveWriter&) = delete;
+
+	inline bool isValid() const { return m_file.is_open() && m_file.good(); }
+	inline SizeType size() const { return m_offsets.size() - 1; }
+
+	inline bool append(const BigNumber& value);
+
+	// Writes the index and the header, false when the file could not be written
+	inline bool close();
+
+private:
+	std::ofstream				m_file;
+	std::vector<uint64_t>		m_offsets;
+	std::vector<unsigned char>	m_buffer;
+};
+
+ArchiveWriter::ArchiveWriter(const std::string& path)
+	: m_file(path, std::ios::binary | std::ios::trunc)
+	, m_offsets{ nsSerial::kARCHIVE_HEADER_SIZE }
+{
+	if (!m_file.is_open())
+	{
+		LOG_ERROR("Unable to create " << path);
+		return;
+	}
+	// Filled in by close, an archive that was never closed has no magic
+	const unsigned char header[nsSerial::kARCHIVE_HEADER_SIZE]{};
+	m_file.write(reinterpret_cast<const char*>(header), sizeof(header));
+}
+
+bool ArchiveWriter::append(const BigNumber& value)
+{
+	if (!isValid())
+	{
+		LOG_ERROR("INVALID Operation!");
+		return false;
+	}
+	m_buffer.resize(serializedSize(value));
+	const SizeType bytes = serialize(value, m_buffer.data(), m_buffer.size());
+	m_file.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(bytes));
+	m_offsets.push_back(m_offsets.back() + bytes);
+	return isValid();
+}
+
+bool ArchiveWriter::close()
+{
+	if (!m_file.is_open())
+	{
+		return false;
+	}
+	bool written = m_file.good();
+	if (written)
+	{
+		std::vector<unsigned char> index(m_offsets.size() * 8);
+		for (SizeType i = 0; i < m_offsets.size(); ++i)
+		{
+			nsSerial::storeLE(index.data() + 8 * i, m_offsets[i]);
+		}
+		m_file.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(index.size()));
+
+		unsigned char header[nsSerial::kARCHIVE_HEADER_SIZE]{};
+		std::memcpy(header, nsSerial::kARCHIVE_MAGIC, sizeof(nsSerial::kARCHIVE_MAGIC));
+		header[4] = nsSerial::kARCHIVE_VERSION;
+		nsSerial::storeLE(header + 8, size());
+		nsSerial::storeLE(header + 16, m_offsets.back());
+		m_file.seekp(0);
+		m_file.write(reinterpret_cast<const char*>(header), sizeof(header));
+		m_file.flush();
+		written = m_file.good();
+	}
+	m_file.close();
+	if (!written)
+	{
+		LOG_ERROR("Unable to write the archive!");
+	}
+	return written;
+}
+
+// An archive mapped read only. Views borrow their limbs from the mapping and have to go before it.
+class MappedArchive
+{
+	using SizeType = size_t;
+public:
+	inline explicit MappedArchive(const std::string& path);
+	~MappedArchive() { unmap(); }
+
+	MappedArchive(const MappedArchive&) = delete;
+	MappedArchive& operator=(const MappedArchive&) = delete;
+
+	inline bool isValid() const { return m_index != nullptr; }
+	inline SizeType size() const { return m_count; }
+
+	// Item i where it lies in the file, an invalid view when i is out of range or the record is damaged
+	inline BigNumberView view(const SizeType i) const;
+	inline BigNumberView operator[](const SizeType i) const { return view(i); }
+
+	// Owning copy of item i
+	inline BigNumber at(const SizeType i) const { return view(i).toBigNumber(); }
+
+private:
+	inline bool map(const std::string& path);
+	inline void unmap();
+
+private:
+	const unsigned char*	m_data{};
+	SizeType				m_bytes{};
+	const unsigned char*	m_index{};
+	SizeType				m_count{};
+#ifdef _WIN32
+	HANDLE					m_mapping{};
+#endif
+};
+
+MappedArchive::MappedArchive(const std::string& path)
+{
+	if (!map(path))
+	{
+		LOG_ERROR("Unable to map " << path);
+		return;
+	}
+	if (m_bytes < nsSerial::kARCHIVE_HEADER_SIZE || std::memcmp(m_data, nsSerial::kARCHIVE_MAGIC, sizeof(nsSerial::kARCHIVE_MAGIC)) != 0
+		|| m_data[4] != nsSerial::kARCHIVE_VERSION)
+	{
+		LOG_ERROR("Not an archive, or an unsupported version!");
+		unmap();
+		return;
+	}
+	// The index has to fill the rest of the file exactly
+	const uint64_t count = nsSerial::loadLE(m_data + 8);
+	const uint64_t indexOffset = nsSerial::loadLE(m_data + 16);
+	const uint64_t entries = indexOffset <= m_bytes ? (m_bytes - indexOffset) / 8 : 0;
+	if (indexOffset < nsSerial::kARCHIVE_HEADER_SIZE || entries == 0 || (m_bytes - indexOffset) % 8 != 0 || entries - 1 != count)
+	{
+		LOG_ERROR("Corrupt archive index!");
+		unmap();
+		return;
+	}
+	m_count = count;
+	m_index = m_data + indexOffset;
+}
+
+BigNumberView MappedArchive::view(const SizeType i) const
+{
+	if (i >= m_count)
+	{
+		LOG_ERROR("Index out of range!");
+		return BigNumberView();
+	}
+	const uint64_t begin = nsSerial::loadLE(m_index + 8 * i);
+	const uint64_t end = nsSerial::loadLE(m_index + 8 * (i + 1));
+	const uint64_t indexOffset = static_cast<uint64_t>(m_index - m_data);
+	if (begin < nsSerial::kARCHIVE_HEADER_SIZE || begin > end || end > indexOffset)
+	{
+		LOG_ERROR("Corrupt archive index!");
+		return BigNumberView();
+	}
+	return BigNumberView(m_data + begin, end - begin);
+}
+
+#ifdef _WIN32
+bool MappedArchive::map(const std::string& path)
+{
+	const HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+	LARGE_INTEGER bytes{};
+	if (!GetFileSizeEx(file, &bytes) || bytes.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+	m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (m_mapping == nullptr)
+	{
+		return false;
+	}
+	m_data = static_cast<const unsigned char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+	m_bytes = static_cast<SizeType>(bytes.QuadPart);
+	return m_data != nullptr;
+}
+
+void MappedArchive::unmap()
+{
+	if (m_data != nullptr)
+	{
+		UnmapViewOfFile(m_data);
+	}
+	if (m_mapping != nullptr)
+	{
+		CloseHandle(m_mapping);
+	}
+	m_mapping = nullptr;
+	m_data = nullptr;
+	m_index = nullptr;
+	m_bytes = m_count = 0;
+}
+#else
+bool MappedArchive::map(const std::string& path)
+{
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return false;
+	}
+	struct stat status{};
+	if (::fstat(fd, &status) != 0 || status.st_size <= 0)
+	{
+		::close(fd);
+		return false;
+	}
+	// The mapping keeps the file alive on its own
+	void* data = ::mmap(nullptr, static_cast<SizeType>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (data == MAP_FAILED)
+	{
+		return false;
+	}
+	m_data = static_cast<const unsigned char*>(data);
+	m_bytes = static_cast<SizeType>(status.st_size);
+	return true;
+}
+
+void MappedArchive::unmap()
+{
+	if (m_data != nullptr)
+	{
+		::munmap(const_cast<unsigned char*>(m_data), m_bytes);
+	}
+	m_data = nullptr;
+	m_index = nullptr;
+	m_bytes = m_count = 0;
+}
+#endif
+}	// namespace nsNumber
+#endif // #ifndef __ARCHIVE_H__
@@ -0,0 +1,331 @@
+/*
+	@file	: digitParser.h
+	@breif	: Incremental parsing of decimal text into BigNumber, from chunks, streams and files
+
+	@NOTE	: Digits are packed into blocks of 19 as the chunks come in, so the text is never held
+			  whole and the blocks take about the space of the final limbs. Fraction digits past
+			  the precision are reduced to one more digit and whether anything after it was non
+			  zero, which rounds the same. The blocks are converted to limbs once, at the end.
+*/
+
+#ifndef __DIGIT_PARSER_H__
+#define __DIGIT_PARSER_H__
+
+#include <algorithm>
+#include <cctype>
+#include <istream>
+#include <string>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "BigNumber.h"
+
+namespace nsNumber
+{
+// Accepts what BigNumber(const std::string&) does, with whitespace around the number
+class DigitParser
+{
+	using SizeType		= size_t;
+	using Limb			= nsLimb::Limb;
+	using LimbVector	= nsLimb::LimbVector;
+public:
+	// Size of the chunks read from streams and files
+	static constexpr SizeType kCHUNK_SIZE = 16384;
+
+	explicit DigitParser(const SizeType precision = BigNumber::kPRECISION) : m_precision(precision) {}
+
+	// Takes the next chunk of text, the number ends at the first whitespace after it
+	inline void feed(const char* chunk, const SizeType count);
+
+	inline bool isValid() const { return m_state != State::kINVALID; }
+	inline bool isDone() const { return m_state == State::kDONE; }
+
+	// The number read so far, rounded to the precision. Text that is not a number is logged and gives
+	// an empty BigNumber, as the string constructor does. The parser starts over afterwards.
+	inline BigNumber finish();
+
+	// One number from in. Whitespace before it is skipped and in is left at the whitespace after it.
+	static inline BigNumber read(std::istream& in, const SizeType precision = BigNumber::kPRECISION);
+
+	// Everything up to the end of the file behind fd
+	static inline BigNumber readFile(const int fd, const SizeType precision = BigNumber::kPRECISION);
+
+	// Everything source hands over, source(buffer, capacity) fills buffer and returns the count, 0 at the end
+	template <typename Source>
+	static inline BigNumber readChunks(Source&& source, const SizeType precision = BigNumber::kPRECISION);
+
+private:
+	enum class State : uint8_t
+	{
+		kSTART,
+		kSIGN,
+		kDIGITS,
+		kWORD,
+		kDONE,
+		kINVALID
+	};
+
+	// NAN and INFINITY are the only words
+	static constexpr SizeType kMAX_WORD = 8;
+
+	inline void digit(const Limb d);
+	inline void pushDigit(const Limb d);
+
+private:
+	SizeType		m_precision;
+	State			m_state{ State::kSTART };
+	bool			m_negative{};
+	bool			m_point{};
+	bool			m_anyDigit{};
+	bool			m_sticky{};
+	LimbVector		m_blocks;				// full blocks of 19 digits, most significant first
+	Limb			m_block{};				// digits after the last full block
+	unsigned		m_blockDigits{};
+	SizeType		m_fractionDigits{};		// kept, at most m_precision + 1
+	std::string		m_word;
+};
+
+void DigitParser::feed(const char* chunk, const SizeType count)
+{
+	for (SizeType i = 0; i < count && m_state != State::kINVALID; ++i)
+	{
+		const char ch = chunk[i];
+		const bool space = std::isspace(static_cast<unsigned char>(ch)) != 0;
+		switch (m_state)
+		{
+		case State::kSTART:
+			if (space)
+			{
+				break;
+			}
+			if (ch == '-')
+			{
+				m_negative = true;
+				m_state = State::kSIGN;
+				break;
+			}
+			[[fallthrough]];
+		case State::kSIGN:
+			if (std::isalpha(static_cast<unsigned char>(ch)))
+			{
+				m_state = State::kWORD;
+				m_word.push_back(ch);
+				break;
+			}
+			m_state = State::kDIGITS;
+			[[fallthrough]];
+		case State::kDIGITS:
+			if (ch >= '0' && ch <= '9')
+			{
+				digit(static_cast<Limb>(ch - '0'));
+			}
+			else if (ch == '.' && !m_point)
+			{
+				m_point = true;
+			}
+			else
+			{
+				m_state = space ? State::kDONE : State::kINVALID;
+			}
+			break;
+		case State::kWORD:
+			if (space)
+			{
+				m_state = State::kDONE;
+			}
+			else if (std::isalpha(static_cast<unsigned char>(ch)) && m_word.size() < kMAX_WORD)
+			{
+				m_word.push_back(ch);
+			}
+			else
+			{
+				m_state = State::kINVALID;
+			}
+			break;
+		case State::kDONE:
+			if (!space)
+			{
+				m_state = State::kINVALID;
+			}
+			break;
+		case State::kINVALID:
+			break;
+		}
+	}
+}
+
+void DigitParser::digit(const Limb d)
+{
+	m_anyDigit = true;
+	if (m_point)
+	{
+		if (m_fractionDigits > m_precision)
+		{
+			m_sticky = m_sticky || d != 0;
+			return;
+		}
+		m_fractionDigits++;
+	}
+	pushDigit(d);
+}
+
+void DigitParser::pushDigit(const Limb d)
+{
+	// Leading zeros carry no value
+	if (d == 0 && m_blockDigits == 0 && m_blocks.empty())
+	{
+		return;
+	}
+	m_block = m_block * 10 + d;
+	if (++m_blockDigits == nsLimb::kDECIMAL_BLOCK_DIGITS)
+	{
+		m_blocks.push_back(m_block);
+		m_block = 0;
+		m_blockDigits = 0;
+	}
+}
+
+BigNumber DigitParser::finish()
+{
+	BigNumber result;
+	if (m_state == State::kINVALID || (m_word.empty() && !m_anyDigit))
+	{
+		LOG_ERROR("Invalid number.");
+		result.clear();
+	}
+	else if (!m_word.empty())
+	{
+		if (m_word == "NAN" && !m_negative)
+		{
+			result = sNAN;
+		}
+		else if (m_word == "INFINITY")
+		{
+			result = m_negative ? -sINFINITY : sINFINITY;
+		}
+		else
+		{
+			LOG_ERROR("Invalid number.");
+			result.clear();
+		}
+	}
+	else
+	{
+		// A non zero digit past the kept ones, as a 1 behind them, rounds the same as all of them
+		if (m_sticky)
+		{
+			m_fractionDigits++;
+			pushDigit(1);
+		}
+		std::reverse(m_blocks.begin(), m_blocks.end());
+		result.m_limbs = nsLimb::fromDecimalBlocks(m_blocks.data(), m_blocks.size());
+		m_blocks = LimbVector();
+
+		nsLimb::multiplyByPow10(result.m_limbs, m_blockDigits);
+		const Limb carry = nsLimb::addLimb(result.m_limbs.data(), result.m_limbs.data(), result.m_limbs.size(), m_block);
+		if (carry)
+		{
+			result.m_limbs.push_back(carry);
+		}
+		result.m_precision = m_precision;
+		result.m_scale = static_cast<BigNumber::ScaleType>(m_fractionDigits);
+		result.m_bNegative = m_negative;
+		result.roundOff(m_precision);
+		result.trimZeros();
+	}
+
+	*this = DigitParser(m_precision);
+	return result;
+}
+
+BigNumber DigitParser::read(std::istream& in, const SizeType precision)
+{
+	DigitParser parser(precision);
+	std::streambuf* buffer = in.rdbuf();
+	if (!in.good() || buffer == nullptr)
+	{
+		in.setstate(std::ios::failbit);
+		return parser.finish();
+	}
+
+	char chunk[kCHUNK_SIZE];
+	SizeType count = 0;
+	bool started = false;
+	for (int ch = buffer->sgetc(); ; ch = buffer->snextc())
+	{
+		if (ch == std::char_traits<char>::eof())
+		{
+			in.setstate(std::ios::eofbit);
+			break;
+		}
+		const bool space = std::isspace(ch) != 0;
+		if (space && started)
+		{
+			break;
+		}
+		started = started || !space;
+		chunk[count++] = static_cast<char>(ch);
+		if (count == kCHUNK_SIZE)
+		{
+			parser.feed(chunk, count);
+			count = 0;
+		}
+	}
+	parser.feed(chunk, count);
+	BigNumber result = parser.finish();
+	if (result.empty())
+	{
+		in.setstate(std::ios::failbit);
+	}
+	return result;
+}
+
+BigNumber DigitParser::readFile(const int fd, const SizeType precision)
+{
+	DigitParser parser(precision);
+	char chunk[kCHUNK_SIZE];
+	while (parser.isValid())
+	{
+#ifdef _WIN32
+		const int count = ::_read(fd, chunk, static_cast<unsigned>(kCHUNK_SIZE));
+#else
+		const ssize_t count = ::read(fd, chunk, kCHUNK_SIZE);
+#endif
+		if (count < 0)
+		{
+			LOG_ERROR("Unable to read the file!");
+			parser.m_state = State::kINVALID;
+		}
+		if (count <= 0)
+		{
+			break;
+		}
+		parser.feed(chunk, static_cast<SizeType>(count));
+	}
+	return parser.finish();
+}
+
+template <typename Source>
+BigNumber DigitParser::readChunks(Source&& source, const SizeType precision)
+{
+	DigitParser parser(precision);
+	char chunk[kCHUNK_SIZE];
+	for (SizeType count = source(chunk, kCHUNK_SIZE); count > 0 && parser.isValid(); count = source(chunk, kCHUNK_SIZE))
+	{
+		parser.feed(chunk, count);
+	}
+	return parser.finish();
+}
+
+// Reads one number as DigitParser::read does, with the precision of value. Failbit is set on text that is not a number.
+inline std::istream& operator>>(std::istream& in, BigNumber& value)
+{
+	value = DigitParser::read(in, value.getMaxPrecision());
+	return in;
+}
+}	// namespace nsNumber
+#endif // #ifndef __DIGIT_PARSER_H__
@@ -29,6 +29,11 @@ public:
         return std::chrono::duration_cast<std::chrono::milliseconds>(end - m_start);
     }
 
+    inline std::chrono::microseconds getElapsedUS() {
+        const auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::microseconds>(end - m_start);
+    }
+
     inline void print(std::string msg)
     {
         PRINT_MSG(msg + std::to_string(getElapsedMS().count()) + " ms.");
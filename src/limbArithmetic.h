@@ -0,0 +1,408 @@
+/*
+	@file	: limbArithmetic.h
+	@breif	: Low level kernels working on little endian arrays of 64 bit limbs
+
+	@NOTE	: All kernels take raw pointers and sizes, the caller owns the memory.
+			  Carries are propagated through a 128 bit accumulator.
+
+			  Limbs are binary (radix 2^64) by default. Building with BIGNUMBER_DECIMAL_LIMBS
+			  keeps every limb in radix 10^19 instead, i.e. 19 decimal digits per limb, which
+			  makes decimal rounding and text conversion a matter of digit arithmetic.
+*/
+
+#ifndef __LIMB_ARITHMETIC_H__
+#define __LIMB_ARITHMETIC_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+#include "limbVector.h"
+
+#if !defined(__SIZEOF_INT128__)
+	#error "BigNumber limb arithmetic needs a compiler with unsigned __int128 support"
+#endif
+
+namespace nsNumber
+{
+namespace nsLimb
+{
+// storing magnitude in reverse
+// at 0 index we will have least significant limb
+using Limb			= uint64_t;
+__extension__ typedef unsigned __int128 DoubleLimb;
+using SizeType		= size_t;
+
+constexpr unsigned kLIMB_BITS = 64;
+
+#ifdef BIGNUMBER_DECIMAL_LIMBS
+constexpr bool kDECIMAL_LIMBS = true;
+constexpr Limb kLIMB_MAX = 9999999999999999999ULL;
+#else
+constexpr bool kDECIMAL_LIMBS = false;
+constexpr Limb kLIMB_MAX = ~static_cast<Limb>(0);
+#endif
+constexpr DoubleLimb kLIMB_BASE = static_cast<DoubleLimb>(kLIMB_MAX) + 1;
+
+constexpr unsigned countLeadingZeros(const Limb val) { return val ? static_cast<unsigned>(__builtin_clzll(val)) : kLIMB_BITS; }
+
+// Division of a two limb number by an invariant limb using a precomputed reciprocal.
+// Moller & Granlund, "Improved division by invariant integers", algorithm 4.
+class LimbDivisor
+{
+public:
+	constexpr explicit LimbDivisor(const Limb divisor)
+		: m_shift(countLeadingZeros(divisor))
+		, m_divisor(divisor << m_shift)
+		, m_inverse(static_cast<Limb>(~static_cast<DoubleLimb>(0) / m_divisor))
+	{}
+
+	inline unsigned shift() const { return m_shift; }
+	inline Limb divisor() const { return m_divisor >> m_shift; }
+
+	// (high, low) / normalized divisor, requires high < normalized divisor
+	inline Limb divide(const Limb high, const Limb low, Limb& remainder) const
+	{
+		DoubleLimb q = static_cast<DoubleLimb>(m_inverse) * high;
+		q += (static_cast<DoubleLimb>(high) << kLIMB_BITS) | low;
+		Limb q1 = static_cast<Limb>(q >> kLIMB_BITS) + 1;
+		const Limb q0 = static_cast<Limb>(q);
+		Limb r = low - q1 * m_divisor;
+		if (r > q0)
+		{
+			q1--;
+			r += m_divisor;
+		}
+		if (r >= m_divisor)
+		{
+			q1++;
+			r -= m_divisor;
+		}
+		remainder = r;
+		return q1;
+	}
+
+	// (high * kLIMB_BASE + low) / divisor, requires high < divisor
+	inline Limb divideLimbs(const Limb high, const Limb low, Limb& remainder) const
+	{
+		if (!kDECIMAL_LIMBS)
+		{
+			if (m_shift == 0)
+			{
+				return divide(high, low, remainder);
+			}
+			const Limb q = divide((high << m_shift) | (low >> (kLIMB_BITS - m_shift)), low << m_shift, remainder);
+			remainder >>= m_shift;
+			return q;
+		}
+		const DoubleLimb val = (static_cast<DoubleLimb>(high) * kLIMB_BASE + low) << m_shift;
+		const Limb q = divide(static_cast<Limb>(val >> kLIMB_BITS), static_cast<Limb>(val), remainder);
+		remainder >>= m_shift;
+		return q;
+	}
+
+	// q = a / divisor, q has n limbs and may alias a, returns the remainder
+	inline Limb divRem(Limb* q, const Limb* a, SizeType n) const
+	{
+		if (n == 0)
+		{
+			return 0;
+		}
+		Limb r = 0;
+		if (kDECIMAL_LIMBS)
+		{
+			for (SizeType i = n; i-- > 0;)
+			{
+				q[i] = divideLimbs(r, a[i], r);
+			}
+			return r;
+		}
+		if (m_shift == 0)
+		{
+			for (SizeType i = n; i-- > 0;)
+			{
+				q[i] = divide(r, a[i], r);
+			}
+			return r;
+		}
+		r = a[n - 1] >> (kLIMB_BITS - m_shift);
+		for (SizeType i = n; i-- > 0;)
+		{
+			const Limb low = (a[i] << m_shift) | (i > 0 ? a[i - 1] >> (kLIMB_BITS - m_shift) : 0);
+			q[i] = divide(r, low, r);
+		}
+		return r >> m_shift;
+	}
+
+	// a % divisor
+	inline Limb mod(const Limb* a, SizeType n) const
+	{
+		Limb r = 0;
+		if (kDECIMAL_LIMBS)
+		{
+			for (SizeType i = n; i-- > 0;)
+			{
+				divideLimbs(r, a[i], r);
+			}
+			return r;
+		}
+		if (m_shift == 0)
+		{
+			for (SizeType i = n; i-- > 0;)
+			{
+				divide(r, a[i], r);
+			}
+			return r;
+		}
+		if (n == 0)
+		{
+			return 0;
+		}
+		r = a[n - 1] >> (kLIMB_BITS - m_shift);
+		for (SizeType i = n; i-- > 0;)
+		{
+			const Limb low = (a[i] << m_shift) | (i > 0 ? a[i - 1] >> (kLIMB_BITS - m_shift) : 0);
+			divide(r, low, r);
+		}
+		return r >> m_shift;
+	}
+
+private:
+	unsigned	m_shift;
+	Limb		m_divisor;
+	Limb		m_inverse;
+};
+
+#ifdef BIGNUMBER_DECIMAL_LIMBS
+constexpr LimbDivisor kRADIX_DIVISOR{ kLIMB_MAX + 1 };
+#endif
+
+// Splits val < kLIMB_BASE * 2^64 into val = high * kLIMB_BASE + low, returns low
+inline Limb splitLimb(const DoubleLimb val, Limb& high)
+{
+#ifdef BIGNUMBER_DECIMAL_LIMBS
+	Limb low{};
+	high = kRADIX_DIVISOR.divide(static_cast<Limb>(val >> kLIMB_BITS), static_cast<Limb>(val), low);
+	return low;
+#else
+	high = static_cast<Limb>(val >> kLIMB_BITS);
+	return static_cast<Limb>(val);
+#endif
+}
+
+inline SizeType normalizedSize(const Limb* a, SizeType n)
+{
+	while (n > 0 && a[n - 1] == 0)
+	{
+		n--;
+	}
+	return n;
+}
+
+inline void normalize(LimbVector& a) { a.resize(normalizedSize(a.data(), a.size())); }
+
+inline bool isZero(const LimbVector& a) { return normalizedSize(a.data(), a.size()) == 0; }
+
+// Returns -1, 0 or 1. Leading zero limbs are allowed on both sides.
+inline int compare(const Limb* a, SizeType an, const Limb* b, SizeType bn)
+{
+	an = normalizedSize(a, an);
+	bn = normalizedSize(b, bn);
+	if (an != bn)
+	{
+		return an < bn ? -1 : 1;
+	}
+	for (SizeType i = an; i-- > 0;)
+	{
+		if (a[i] != b[i])
+		{
+			return a[i] < b[i] ? -1 : 1;
+		}
+	}
+	return 0;
+}
+
+inline int compare(const LimbVector& a, const LimbVector& b) { return compare(a.data(), a.size(), b.data(), b.size()); }
+
+// Magnitudes of up to two limbs as a native 128 bit value, false when a does not fit
+inline bool toDoubleLimb(const LimbVector& a, DoubleLimb& val)
+{
+	const SizeType n = normalizedSize(a.data(), a.size());
+	if (n > 2)
+	{
+		return false;
+	}
+	val = (n == 0) ? 0 : a[0];
+	if (n == 2)
+	{
+		val += static_cast<DoubleLimb>(a[1]) * kLIMB_BASE;
+	}
+	return true;
+}
+
+inline void fromDoubleLimb(DoubleLimb val, LimbVector& a)
+{
+	a.clear();
+	while (val)
+	{
+		a.push_back(static_cast<Limb>(val % kLIMB_BASE));
+		val /= kLIMB_BASE;
+	}
+}
+
+// r = a + v, r has n limbs and may alias a, returns the carry out
+inline Limb addLimb(Limb* r, const Limb* a, SizeType n, Limb v)
+{
+	for (SizeType i = 0; i < n && (v || r != a); ++i)
+	{
+		const DoubleLimb s = static_cast<DoubleLimb>(a[i]) + v;
+		v = (s >= kLIMB_BASE) ? 1 : 0;
+		r[i] = static_cast<Limb>(v ? s - kLIMB_BASE : s);
+	}
+	return v;
+}
+
+// r = a - v, r has n limbs and may alias a, returns the borrow out
+inline Limb subLimb(Limb* r, const Limb* a, SizeType n, Limb v)
+{
+	for (SizeType i = 0; i < n && (v || r != a); ++i)
+	{
+		const DoubleLimb d = static_cast<DoubleLimb>(a[i]) + kLIMB_BASE - v;
+		v = (d < kLIMB_BASE) ? 1 : 0;
+		r[i] = static_cast<Limb>(v ? d : d - kLIMB_BASE);
+	}
+	return v;
+}
+
+// r = a + b where an >= bn, r has an limbs and may alias a or b, returns the carry out
+inline Limb add(Limb* r, const Limb* a, SizeType an, const Limb* b, SizeType bn)
+{
+	Limb carry = 0;
+	for (SizeType i = 0; i < bn; ++i)
+	{
+		const DoubleLimb s = static_cast<DoubleLimb>(a[i]) + b[i] + carry;
+		carry = (s >= kLIMB_BASE) ? 1 : 0;
+		r[i] = static_cast<Limb>(carry ? s - kLIMB_BASE : s);
+	}
+	return addLimb(r + bn, a + bn, an - bn, carry);
+}
+
+// r = a - b where an >= bn, r has an limbs and may alias a or b, returns the borrow out
+inline Limb sub(Limb* r, const Limb* a, SizeType an, const Limb* b, SizeType bn)
+{
+	Limb borrow = 0;
+	for (SizeType i = 0; i < bn; ++i)
+	{
+		const DoubleLimb d = static_cast<DoubleLimb>(a[i]) + kLIMB_BASE - b[i] - borrow;
+		borrow = (d < kLIMB_BASE) ? 1 : 0;
+		r[i] = static_cast<Limb>(borrow ? d : d - kLIMB_BASE);
+	}
+	return subLimb(r + bn, a + bn, an - bn, borrow);
+}
+
+// r = a * v, r has n limbs and may alias a, returns the high limb
+inline Limb mulLimb(Limb* r, const Limb* a, SizeType n, Limb v)
+{
+	Limb carry = 0;
+	for (SizeType i = 0; i < n; ++i)
+	{
+		r[i] = splitLimb(static_cast<DoubleLimb>(a[i]) * v + carry, carry);
+	}
+	return carry;
+}
+
+// r += a * v over n limbs, returns the high limb
+inline Limb addMulLimb(Limb* r, const Limb* a, SizeType n, Limb v)
+{
+	Limb carry = 0;
+	for (SizeType i = 0; i < n; ++i)
+	{
+		r[i] = splitLimb(static_cast<DoubleLimb>(a[i]) * v + r[i] + carry, carry);
+	}
+	return carry;
+}
+
+// r -= a * v over n limbs, returns the limb that has to be borrowed from r[n]
+inline Limb subMulLimb(Limb* r, const Limb* a, SizeType n, Limb v)
+{
+	Limb carry = 0;
+	for (SizeType i = 0; i < n; ++i)
+	{
+		Limb high{};
+		const Limb low = splitLimb(static_cast<DoubleLimb>(a[i]) * v + carry, high);
+		carry = high + (r[i] < low ? 1 : 0);
+		r[i] = (r[i] < low) ? static_cast<Limb>(r[i] + kLIMB_BASE - low) : r[i] - low;
+	}
+	return carry;
+}
+
+// Binary limbs only
+// r = a << bits, 0 < bits < kLIMB_BITS, r may alias a, returns the bits shifted out
+inline Limb shiftLeft(Limb* r, const Limb* a, SizeType n, unsigned bits)
+{
+	Limb out = 0;
+	for (SizeType i = 0; i < n; ++i)
+	{
+		const Limb val = a[i];
+		r[i] = (val << bits) | out;
+		out = val >> (kLIMB_BITS - bits);
+	}
+	return out;
+}
+
+// Binary limbs only
+// r = a >> bits, 0 < bits < kLIMB_BITS, r may alias a, returns the bits shifted out (in the high end of the limb)
+inline Limb shiftRight(Limb* r, const Limb* a, SizeType n, unsigned bits)
+{
+	Limb out = 0;
+	for (SizeType i = n; i-- > 0;)
+	{
+		const Limb val = a[i];
+		r[i] = (val >> bits) | out;
+		out = val << (kLIMB_BITS - bits);
+	}
+	return out;
+}
+
+
+// q = a / d, q has n limbs and may alias a, returns the remainder
+inline Limb divRemLimb(Limb* q, const Limb* a, SizeType n, Limb d) { return LimbDivisor(d).divRem(q, a, n); }
+
+inline Limb modLimb(const Limb* a, SizeType n, Limb d) { return LimbDivisor(d).mod(a, n); }
+
+// a as 64 bit binary words, least significant first. A single decimal limb is already a word.
+inline LimbVector binaryWords(const LimbVector& a)
+{
+	if (!kDECIMAL_LIMBS || normalizedSize(a.data(), a.size()) <= 1)
+	{
+		return a;
+	}
+	constexpr Limb kHALF_WORD = static_cast<Limb>(1) << 32;
+	LimbVector rest(a);
+	normalize(rest);
+	LimbVector words;
+	for (SizeType i = 0; !rest.empty(); ++i)
+	{
+		const Limb digit = divRemLimb(rest.data(), rest.data(), rest.size(), kHALF_WORD);
+		normalize(rest);
+		if (i & 1)
+		{
+			words.back() |= digit << 32;
+		}
+		else
+		{
+			words.push_back(digit);
+		}
+	}
+	return words;
+}
+
+// Number of significant bits in binary words, 0 for zero
+inline SizeType bitLength(const LimbVector& words)
+{
+	const SizeType n = normalizedSize(words.data(), words.size());
+	return n ? n * kLIMB_BITS - countLeadingZeros(words[n - 1]) : 0;
+}
+}	// namespace nsLimb
+}	// namespace nsNumber
+#endif // #ifndef __LIMB_ARITHMETIC_H__
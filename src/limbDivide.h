@@ -0,0 +1,360 @@
+/*
+	@file	: limbDivide.h
+	@breif	: Division kernels on limb arrays
+*/
+
+#ifndef __LIMB_DIVIDE_H__
+#define __LIMB_DIVIDE_H__
+
+#include "limbArithmetic.h"
+#include "limbMultiply.h"
+
+namespace nsNumber
+{
+namespace nsLimb
+{
+// Divisor size (in limbs) from where the burnikel-ziegler recursion beats the schoolbook division
+constexpr SizeType kRECURSIVE_DIVISION_THRESHOLD = 60;
+// Divisor size (in limbs) and number of quotient blocks from where computing a newton reciprocal
+// once and dividing every block by it beats the recursion, the reciprocal costs about five products
+constexpr SizeType kNEWTON_DIVISION_THRESHOLD = 16000;
+constexpr SizeType kNEWTON_DIVISION_BLOCKS = 4;
+
+// Knuth step D1, the scaling that brings the top limb of a divisor to at least half the base.
+// Binary limbs are shifted by the leading zero bits, decimal limbs multiplied by base / (top + 1).
+class Normalizer
+{
+public:
+	explicit Normalizer(const Limb top)
+		: m_shift(countLeadingZeros(top))
+		, m_factor(static_cast<Limb>(kLIMB_BASE / (static_cast<DoubleLimb>(top) + 1)))
+	{}
+
+	// r = a * scale, r has n limbs and may alias a, returns the limb carried out
+	inline Limb apply(Limb* r, const Limb* a, SizeType n) const
+	{
+		if (kDECIMAL_LIMBS)
+		{
+			return mulLimb(r, a, n, m_factor);
+		}
+		if (m_shift > 0)
+		{
+			return shiftLeft(r, a, n, m_shift);
+		}
+		std::copy(a, a + n, r);
+		return 0;
+	}
+
+	// r = a / scale, r has n limbs and may alias a, a has to be a multiple of the scale
+	inline void undo(Limb* r, const Limb* a, SizeType n) const
+	{
+		if (kDECIMAL_LIMBS)
+		{
+			divRemLimb(r, a, n, m_factor);
+		}
+		else if (m_shift > 0)
+		{
+			shiftRight(r, a, n, m_shift);
+		}
+		else
+		{
+			std::copy(a, a + n, r);
+		}
+	}
+
+private:
+	unsigned	m_shift;
+	Limb		m_factor;
+};
+
+// Knuth, TAOCP vol. 2, 4.3.1 algorithm D, steps D2 to D7 on an already normalized divisor.
+// u has un limbs with its top vn limbs below v, v has vn >= 2 limbs and is normalized.
+// q gets (un - vn) limbs, the remainder is left in the low vn limbs of u and the rest of u is cleared.
+// topDivisor divides by the top limb of v, its precomputed inverse keeps the loop free of divisions.
+inline void schoolbookDivide(Limb* q, Limb* u, SizeType un, const Limb* v, SizeType vn, const LimbDivisor& topDivisor)
+{
+	const Limb vTop = v[vn - 1];
+	const Limb vNext = v[vn - 2];
+	for (SizeType j = un - vn; j-- > 0;)
+	{
+		// D3, estimate from the top two limbs, the window value is below v * base so window[vn] <= vTop
+		Limb* window = u + j;
+		Limb qhat = kLIMB_MAX;
+		DoubleLimb rhat = static_cast<DoubleLimb>(window[vn - 1]) + vTop;
+		if (window[vn] < vTop)
+		{
+			Limb rem{};
+			qhat = topDivisor.divideLimbs(window[vn], window[vn - 1], rem);
+			rhat = rem;
+		}
+		while (rhat < kLIMB_BASE && static_cast<DoubleLimb>(qhat) * vNext > rhat * kLIMB_BASE + window[vn - 2])
+		{
+			qhat--;
+			rhat += vTop;
+		}
+
+		// D4 to D6, multiply and subtract, add back in the rare case qhat was still one too large
+		const Limb borrow = subMulLimb(window, v, vn, qhat);
+		if (window[vn] < borrow)
+		{
+			qhat--;
+			add(window, window, vn, v, vn);
+		}
+		window[vn] = 0;
+		q[j] = qhat;
+	}
+}
+
+// Recursive division, Brent & Zimmermann, "Modern Computer Arithmetic", algorithm 1.8 (Burnikel-Ziegler).
+// u has (n + m) limbs with its top n limbs below 2 * v, m <= n, v has n limbs and is normalized.
+// q gets m limbs and the limb above them is returned (0 or 1), the remainder is left in the low
+// n limbs of u and the rest of u is cleared. Both halves of the quotient come from dividing by
+// the top (n - k) limbs of v, which costs two half sized divisions and two multiplications.
+// The top limb of v, and so topDivisor, never changes.
+inline Limb recursiveDivide(Limb* q, Limb* u, SizeType m, const Limb* v, SizeType n, const LimbDivisor& topDivisor)
+{
+	// Only the top limbs of the divisor are passed down, so they may not exceed the top of u
+	Limb qh = 0;
+	if (compare(u + m, n, v, n) >= 0)
+	{
+		sub(u + m, u + m, n, v, n);
+		qh = 1;
+	}
+	if (m < kRECURSIVE_DIVISION_THRESHOLD)
+	{
+		schoolbookDivide(q, u, n + m, v, n, topDivisor);
+		return qh;
+	}
+	if (n > m)
+	{
+		// A short quotient only needs the top m limbs of v, the low d limbs are taken off afterwards
+		const SizeType d = n - m;
+		Limb qHigh = recursiveDivide(q, u + d, m, v + d, m, topDivisor);
+		LimbVector product(n);
+		multiply(product.data(), q, m, v, d);
+		Limb borrow = sub(u, u, n, product.data(), n);
+		if (qHigh)
+		{
+			borrow += sub(u + m, u + m, d, v, d);
+		}
+		while (borrow)
+		{
+			qHigh -= subLimb(q, q, m, 1);
+			borrow -= add(u, u, n, v, n);
+		}
+		return qh;
+	}
+	const SizeType k = m / 2;
+
+	// High (m - k) quotient limbs, then take off what the low k limbs of v contribute
+	Limb qHigh = recursiveDivide(q + k, u + 2 * k, m - k, v + k, n - k, topDivisor);
+	LimbVector product(m);
+	multiply(product.data(), q + k, m - k, v, k);
+	Limb borrow = sub(u + k, u + k, n, product.data(), m);
+	if (qHigh)
+	{
+		borrow += sub(u + m, u + m, n + k - m, v, k);
+	}
+	while (borrow)
+	{
+		qHigh -= subLimb(q + k, q + k, m - k, 1);
+		borrow -= add(u + k, u + k, n, v, n);
+	}
+
+	// Low k quotient limbs from what is left
+	qHigh = recursiveDivide(q, u + k, k, v + k, n - k, topDivisor);
+	product.resize(2 * k);
+	multiply(product.data(), q, k, v, k);
+	borrow = sub(u, u, n, product.data(), 2 * k);
+	if (qHigh)
+	{
+		borrow += sub(u + k, u + k, n - k, v, k);
+	}
+	while (borrow)
+	{
+		qHigh -= subLimb(q, q, k, 1);
+		borrow -= add(u, u, n, v, n);
+	}
+	return qh;
+}
+
+// x = floor((base^(2n) - 1) / v), x has (n + 1) limbs, v has n limbs and is normalized.
+// Newton iteration x' = x + x * (base^(2n) - v * x) / base^(2n), started from the reciprocal of
+// the top half of v, doubles the correct limbs. The result is made exact by a final adjustment.
+inline void reciprocal(Limb* x, const Limb* v, SizeType n)
+{
+	if (n < 2 * kRECURSIVE_DIVISION_THRESHOLD)
+	{
+		LimbVector u(2 * n + 1, kLIMB_MAX);
+		u[2 * n] = 0;
+		schoolbookDivide(x, u.data(), 2 * n + 1, v, n, LimbDivisor(v[n - 1]));
+		return;
+	}
+
+	const SizeType h = (n + 1) / 2;
+	const SizeType low = n - h;
+	LimbVector xh(h + 1);
+	reciprocal(xh.data(), v + low, h);
+
+	// f = base^(n + h) - v * xh, small compared to base^(n + h) and of either sign
+	LimbVector f(n + h + 1);
+	multiply(f.data(), v, n, xh.data(), h + 1);
+	const bool negative = f[n + h] != 0;
+	if (negative)
+	{
+		f[n + h] = 0;
+	}
+	else
+	{
+		LimbVector zero(n + h);
+		sub(f.data(), zero.data(), n + h, f.data(), n + h);
+	}
+	const SizeType fn = std::max<SizeType>(normalizedSize(f.data(), f.size()), 1);
+
+	// x = xh * base^low + xh * f / base^(2h)
+	LimbVector correction(h + 1 + fn);
+	multiply(correction.data(), xh.data(), h + 1, f.data(), fn);
+	std::fill(x, x + low, 0);
+	std::copy(xh.begin(), xh.end(), x + low);
+	if (correction.size() > 2 * h)
+	{
+		const SizeType cn = std::min<SizeType>(correction.size() - 2 * h, n + 1);
+		if (negative)
+		{
+			sub(x, x, n + 1, correction.data() + 2 * h, cn);
+		}
+		else
+		{
+			add(x, x, n + 1, correction.data() + 2 * h, cn);
+		}
+	}
+
+	// Exact, v * x <= base^(2n) - 1 < v * (x + 1)
+	LimbVector product(2 * n + 1);
+	multiply(product.data(), x, n + 1, v, n);
+	while (product[2 * n] != 0)
+	{
+		subLimb(x, x, n + 1, 1);
+		sub(product.data(), product.data(), 2 * n + 1, v, n);
+	}
+	for (SizeType i = 0; i < 2 * n; ++i)
+	{
+		product[i] = kLIMB_MAX - product[i];
+	}
+	while (compare(product.data(), 2 * n, v, n) >= 0)
+	{
+		sub(product.data(), product.data(), 2 * n, v, n);
+		addLimb(x, x, n + 1, 1);
+	}
+}
+
+// Division by a precomputed reciprocal x = floor((base^(2n) - 1) / v).
+// u has (n + m) limbs with its top n limbs below v, m <= n, v has n limbs and is normalized.
+// q gets m limbs, the remainder is left in the low n limbs of u and the rest of u is cleared.
+inline void reciprocalDivide(Limb* q, Limb* u, SizeType m, const Limb* v, SizeType n, const Limb* x)
+{
+	// floor(u / base^n) * x / base^n is at most a few below the quotient
+	LimbVector estimate(m + n + 1);
+	multiply(estimate.data(), x, n + 1, u + n, m);
+	std::copy(estimate.begin() + n, estimate.begin() + n + m, q);
+
+	LimbVector product(m + n);
+	multiply(product.data(), v, n, q, m);
+	sub(u, u, n + m, product.data(), n + m);
+	while (compare(u, n + m, v, n) >= 0)
+	{
+		sub(u, u, n + m, v, n);
+		addLimb(q, q, m, 1);
+	}
+}
+
+// q = u / v on a normalized v of vn >= 2 limbs, the top vn limbs of u have to be below v.
+// q gets (un - vn) limbs, the remainder is left in the low vn limbs of u and the rest of u is cleared.
+// topDivisor divides by the top limb of v, x is the reciprocal of v (see reciprocal) or null.
+// The quotient is produced in blocks of at most vn limbs from the top, every block leaves its
+// remainder on top of the next, by schoolbook, recursive or reciprocal division depending on the sizes.
+inline void divideNormalized(Limb* q, Limb* u, SizeType un, const Limb* v, SizeType vn, const LimbDivisor& topDivisor, const Limb* x)
+{
+	const SizeType qn = un - vn;
+	if (x == nullptr && (vn < kRECURSIVE_DIVISION_THRESHOLD || qn < kRECURSIVE_DIVISION_THRESHOLD))
+	{
+		schoolbookDivide(q, u, un, v, vn, topDivisor);
+		return;
+	}
+	for (SizeType end = qn; end > 0;)
+	{
+		const SizeType m = (end == qn && qn % vn != 0) ? qn % vn : vn;
+		const SizeType pos = end - m;
+		if (x == nullptr)
+		{
+			recursiveDivide(q + pos, u + pos, m, v, vn, topDivisor);
+		}
+		else
+		{
+			reciprocalDivide(q + pos, u + pos, m, v, vn, x);
+		}
+		end = pos;
+	}
+}
+
+// q = u / v and r = u % v
+// q has (un - vn + 1) limbs, r has vn limbs, un >= vn, top limb of v is non zero
+// The divisor is normalized so that its top limb is at least half the base (Knuth step D1)
+// and the normalized values are handed to divideNormalized.
+inline void divideAsIntegers(Limb* q, Limb* r, const Limb* u, SizeType un, const Limb* v, SizeType vn)
+{
+	if (vn == 1)
+	{
+		r[0] = divRemLimb(q, u, un, v[0]);
+		return;
+	}
+
+	// D1, normalize
+	LimbVector buffer(un + 1 + vn);
+	Limb* uNorm = buffer.data();
+	Limb* vNorm = uNorm + un + 1;
+	const Normalizer normalizer(v[vn - 1]);
+	normalizer.apply(vNorm, v, vn);
+	uNorm[un] = normalizer.apply(uNorm, u, un);
+
+	// A reciprocal only pays off when it serves enough blocks
+	const SizeType qn = un - vn + 1;
+	LimbVector x;
+	if (vn >= kNEWTON_DIVISION_THRESHOLD && qn >= kNEWTON_DIVISION_BLOCKS * vn)
+	{
+		x.resize(vn + 1);
+		reciprocal(x.data(), vNorm, vn);
+	}
+	divideNormalized(q, uNorm, un + 1, vNorm, vn, LimbDivisor(vNorm[vn - 1]), x.empty() ? nullptr : x.data());
+
+	// D8, unnormalize the remainder
+	normalizer.undo(r, uNorm, vn);
+}
+
+// Convenience wrapper, returns false when dividing by zero
+inline bool divideAsIntegers(const LimbVector& u, const LimbVector& v, LimbVector& quotient, LimbVector& remainder)
+{
+	const SizeType un = normalizedSize(u.data(), u.size());
+	const SizeType vn = normalizedSize(v.data(), v.size());
+	if (vn == 0)
+	{
+		return false;
+	}
+	if (un < vn)
+	{
+		quotient.clear();
+		remainder.assign(u.begin(), u.begin() + un);
+		return true;
+	}
+	LimbVector q(un - vn + 1);
+	LimbVector r(vn);
+	divideAsIntegers(q.data(), r.data(), u.data(), un, v.data(), vn);
+	normalize(q);
+	normalize(r);
+	quotient.swap(q);
+	remainder.swap(r);
+	return true;
+}
+}	// namespace nsLimb
+}	// namespace nsNumber
+#endif // #ifndef __LIMB_DIVIDE_H__
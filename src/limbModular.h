@@ -0,0 +1,434 @@
+/*
+	@file	: limbModular.h
+	@breif	: Reduction modulo a fixed value on limb arrays
+
+	@NOTE	: Everything that only depends on the modulus is computed once up front,
+			  reducing afterwards costs multiplications and no division instruction.
+			  Exponentiation keeps its operands in montgomery form whenever the modulus
+			  allows it.
+*/
+
+#ifndef __LIMB_MODULAR_H__
+#define __LIMB_MODULAR_H__
+
+#include <vector>
+
+#include "limbArithmetic.h"
+#include "limbMultiply.h"
+#include "limbDivide.h"
+
+namespace nsNumber
+{
+namespace nsLimb
+{
+// Modulus size (in limbs) from where barrett reduction beats dividing by the precomputed top limb inverse
+constexpr SizeType kBARRETT_THRESHOLD = 2000;
+// Modulus size (in limbs) up to which the quadratic montgomery reduction beats the division kernels
+constexpr SizeType kMONTGOMERY_THRESHOLD = 128;
+
+// Products modulo an invariant value below 2^128 in native words, whatever the limb radix.
+// Moller & Granlund, "Improved division by invariant integers", algorithms 5 and 6: the modulus is
+// shifted up to a full 128 bits and every 3 by 2 word step costs a few multiplications.
+class DoubleLimbModulus
+{
+public:
+	// modulus has to be at least 2
+	inline explicit DoubleLimbModulus(const DoubleLimb modulus);
+
+	// a * b mod modulus, a and b have to be below the modulus
+	inline DoubleLimb mulMod(const DoubleLimb a, const DoubleLimb b) const;
+
+private:
+	// (u2, u1, u0) mod the shifted modulus, requires (u2, u1) below it
+	inline DoubleLimb remainder(const Limb u2, const Limb u1, const Limb u0) const;
+
+private:
+	unsigned		m_shift;
+	DoubleLimb		m_divisor;
+	Limb			m_inverse;		// floor((2^192 - 1) / m_divisor) - 2^64
+};
+
+DoubleLimbModulus::DoubleLimbModulus(const DoubleLimb modulus)
+	: m_shift(static_cast<Limb>(modulus >> 64) ? countLeadingZeros(static_cast<Limb>(modulus >> 64)) : 64 + countLeadingZeros(static_cast<Limb>(modulus)))
+	, m_divisor(modulus << m_shift)
+	, m_inverse(0)
+{
+	// Algorithm 6, the word reciprocal of the top word corrected for the low one
+	const Limb d1 = static_cast<Limb>(m_divisor >> 64);
+	const Limb d0 = static_cast<Limb>(m_divisor);
+	Limb v = static_cast<Limb>(~static_cast<DoubleLimb>(0) / d1);
+	Limb p = d1 * v + d0;
+	if (p < d0)
+	{
+		v--;
+		if (p >= d1)
+		{
+			v--;
+			p -= d1;
+		}
+		p -= d1;
+	}
+	const DoubleLimb t = static_cast<DoubleLimb>(v) * d0;
+	p += static_cast<Limb>(t >> 64);
+	if (p < static_cast<Limb>(t >> 64))
+	{
+		v--;
+		if (((static_cast<DoubleLimb>(p) << 64) | static_cast<Limb>(t)) >= m_divisor)
+		{
+			v--;
+		}
+	}
+	m_inverse = v;
+}
+
+DoubleLimb DoubleLimbModulus::mulMod(const DoubleLimb a, const DoubleLimb b) const
+{
+	// 256 bit product from four word products
+	const Limb a0 = static_cast<Limb>(a);
+	const Limb a1 = static_cast<Limb>(a >> 64);
+	const Limb b0 = static_cast<Limb>(b);
+	const Limb b1 = static_cast<Limb>(b >> 64);
+	const DoubleLimb low = static_cast<DoubleLimb>(a0) * b0;
+	const DoubleLimb cross1 = static_cast<DoubleLimb>(a0) * b1;
+	const DoubleLimb cross2 = static_cast<DoubleLimb>(a1) * b0;
+	const DoubleLimb middle = (low >> 64) + static_cast<Limb>(cross1) + static_cast<Limb>(cross2);
+	DoubleLimb lo = (middle << 64) | static_cast<Limb>(low);
+	DoubleLimb hi = static_cast<DoubleLimb>(a1) * b1 + (cross1 >> 64) + (cross2 >> 64) + (middle >> 64);
+
+	// Shifted along with the modulus, a * b < modulus * 2^128 keeps the top half below the shifted modulus
+	if (m_shift > 0)
+	{
+		hi = (hi << m_shift) | (lo >> (128 - m_shift));
+		lo <<= m_shift;
+	}
+	const DoubleLimb r = remainder(static_cast<Limb>(hi >> 64), static_cast<Limb>(hi), static_cast<Limb>(lo >> 64));
+	return remainder(static_cast<Limb>(r >> 64), static_cast<Limb>(r), static_cast<Limb>(lo)) >> m_shift;
+}
+
+DoubleLimb DoubleLimbModulus::remainder(const Limb u2, const Limb u1, const Limb u0) const
+{
+	// Algorithm 5, the quotient estimate is off by at most one either way
+	const Limb d1 = static_cast<Limb>(m_divisor >> 64);
+	const DoubleLimb q = static_cast<DoubleLimb>(m_inverse) * u2 + ((static_cast<DoubleLimb>(u2) << 64) | u1);
+	const Limb q1 = static_cast<Limb>(q >> 64);
+	const Limb q0 = static_cast<Limb>(q);
+	const Limb r1 = u1 - q1 * d1;
+	DoubleLimb r = ((static_cast<DoubleLimb>(r1) << 64) | u0) - static_cast<DoubleLimb>(static_cast<Limb>(m_divisor)) * q1 - m_divisor;
+	if (static_cast<Limb>(r >> 64) >= q0)
+	{
+		r += m_divisor;
+	}
+	if (r >= m_divisor)
+	{
+		r -= m_divisor;
+	}
+	return r;
+}
+
+// Repeated reduction modulo one value. The modulus is normalized once together with the inverse of
+// its top limb, which is all the schoolbook and recursive division need, large moduli also get a
+// barrett reciprocal so that a reduction is two multiplications (see reciprocalDivide).
+class ModularReducer
+{
+public:
+	// modulus has to be non zero
+	inline explicit ModularReducer(const LimbVector& modulus);
+
+	inline SizeType size() const { return m_modulus.size(); }
+	inline const LimbVector& modulus() const { return m_modulus; }
+
+	// a = a mod modulus, a can be of any size
+	inline void reduce(LimbVector& a) const;
+	// r = a mod modulus in size() limbs, a has an limbs, scratch has (2 * an + 2) limbs and may start at a
+	inline void reduce(Limb* r, const Limb* a, SizeType an, Limb* scratch) const;
+
+	// Residues of exactly size() limbs, the interface windowedPower expects
+	inline LimbVector enter(const LimbVector& a) const { LimbVector r(a); reduce(r); r.resize(size()); return r; }
+	inline LimbVector leave(const LimbVector& a) const { LimbVector r(a); normalize(r); return r; }
+
+	// Limbs of scratch multiply needs, the product and the reduction of it
+	inline SizeType scratchSize() const { return 4 * size() + 2; }
+
+	// r = a * b mod modulus on residues of size() limbs, r may alias a or b, scratch has scratchSize() limbs
+	inline void multiply(Limb* r, const Limb* a, const Limb* b, Limb* scratch) const;
+
+private:
+	static inline LimbVector normalizedCopy(const LimbVector& a, const Normalizer& normalizer);
+
+private:
+	LimbVector			m_modulus;
+	Normalizer			m_normalizer;
+	LimbVector			m_normalized;
+	LimbDivisor			m_topDivisor;
+	DoubleLimbModulus	m_native;		// Two limb moduli
+	LimbVector			m_reciprocal;
+};
+
+ModularReducer::ModularReducer(const LimbVector& modulus)
+	: m_modulus(modulus.begin(), modulus.begin() + normalizedSize(modulus.data(), modulus.size()))
+	, m_normalizer(m_modulus.back())
+	, m_normalized(normalizedCopy(m_modulus, m_normalizer))
+	, m_topDivisor(m_normalized.back())
+	, m_native(m_modulus.size() == 2 ? m_modulus[0] + static_cast<DoubleLimb>(m_modulus[1]) * kLIMB_BASE : 2)
+{
+	const SizeType n = m_modulus.size();
+	if (n >= kBARRETT_THRESHOLD)
+	{
+		m_reciprocal.resize(n + 1);
+		reciprocal(m_reciprocal.data(), m_normalized.data(), n);
+	}
+}
+
+LimbVector ModularReducer::normalizedCopy(const LimbVector& a, const Normalizer& normalizer)
+{
+	if (a.size() == 1)
+	{
+		return a;
+	}
+	LimbVector normalized(a.size());
+	normalizer.apply(normalized.data(), a.data(), a.size());
+	return normalized;
+}
+
+void ModularReducer::reduce(LimbVector& a) const
+{
+	const SizeType n = m_modulus.size();
+	const SizeType an = normalizedSize(a.data(), a.size());
+	if (compare(a.data(), an, m_modulus.data(), n) < 0)
+	{
+		a.resize(an);
+		return;
+	}
+	LimbVector scratch(n == 1 ? 0 : 2 * an + 2);
+	reduce(a.data(), a.data(), an, scratch.data());
+	a.resize(n);
+	normalize(a);
+}
+
+void ModularReducer::reduce(Limb* r, const Limb* a, SizeType an, Limb* scratch) const
+{
+	const SizeType n = m_modulus.size();
+	an = normalizedSize(a, an);
+	if (compare(a, an, m_modulus.data(), n) < 0)
+	{
+		if (r != a)
+		{
+			std::copy(a, a + an, r);
+		}
+		std::fill(r + an, r + n, 0);
+		return;
+	}
+	if (n == 1)
+	{
+		r[0] = m_topDivisor.mod(a, an);
+		return;
+	}
+
+	// Normalized in place at the start of scratch, the quotient right behind it is thrown away
+	Limb* u = scratch;
+	u[an] = m_normalizer.apply(u, a, an);
+	divideNormalized(u + an + 1, u, an + 1, m_normalized.data(), n, m_topDivisor, m_reciprocal.empty() ? nullptr : m_reciprocal.data());
+	m_normalizer.undo(r, u, n);
+}
+
+void ModularReducer::multiply(Limb* r, const Limb* a, const Limb* b, Limb* scratch) const
+{
+	const SizeType n = size();
+	if (n == 1)
+	{
+		// One native product, its high limb is below the modulus
+		Limb high{};
+		const Limb low = splitLimb(static_cast<DoubleLimb>(a[0]) * b[0], high);
+		m_topDivisor.divideLimbs(high, low, r[0]);
+		return;
+	}
+	if (n == 2)
+	{
+		const DoubleLimb product = m_native.mulMod(a[0] + static_cast<DoubleLimb>(a[1]) * kLIMB_BASE, b[0] + static_cast<DoubleLimb>(b[1]) * kLIMB_BASE);
+		r[0] = splitLimb(product, r[1]);
+		return;
+	}
+	if (a == b)
+	{
+		square(scratch, a, n);
+	}
+	else
+	{
+		nsLimb::multiply(scratch, a, n, b, n);
+	}
+	reduce(r, scratch, 2 * n, scratch);
+}
+
+// Montgomery, "Modular multiplication without trial division". Residues are kept as a * R mod m with
+// R = base^n, the product of two of them is brought back to n limbs by adding multiples of m that clear
+// the low limbs (REDC), one multiply-add row per limb and no quotient estimation.
+// The modulus must not share a factor with the limb base: odd for binary limbs, also not a multiple
+// of five for decimal limbs.
+class MontgomeryReducer
+{
+public:
+	inline explicit MontgomeryReducer(const ModularReducer& reducer);
+
+	static inline bool supports(const LimbVector& modulus) { return !modulus.empty() && (modulus[0] & 1) && (!kDECIMAL_LIMBS || modulus[0] % 5); }
+
+	inline SizeType size() const { return m_modulus.size(); }
+	inline SizeType scratchSize() const { return 2 * size() + 1; }
+
+	// a * R mod m and back, a has to be below the modulus
+	inline LimbVector enter(const LimbVector& a) const;
+	inline LimbVector leave(const LimbVector& a) const;
+
+	// r = a * b / R mod m on residues of size() limbs, r may alias a or b, scratch has scratchSize() limbs
+	inline void multiply(Limb* r, const Limb* a, const Limb* b, Limb* scratch) const;
+
+private:
+	// r = t / R mod m, t has (2 * size() + 1) limbs, is below m * R and gets overwritten
+	inline void reduce(Limb* r, Limb* t) const;
+
+	// -a^-1 modulo the limb base
+	static inline Limb negatedInverse(const Limb a);
+
+private:
+	LimbVector		m_modulus;
+	Limb			m_inverse;
+	LimbVector		m_r2;
+};
+
+MontgomeryReducer::MontgomeryReducer(const ModularReducer& reducer)
+	: m_modulus(reducer.modulus())
+	, m_inverse(negatedInverse(m_modulus[0]))
+	, m_r2(2 * m_modulus.size() + 1)
+{
+	m_r2.back() = 1;
+	reducer.reduce(m_r2);
+	m_r2.resize(size());
+}
+
+LimbVector MontgomeryReducer::enter(const LimbVector& a) const
+{
+	const SizeType n = size();
+	LimbVector r(a);
+	r.resize(n);
+	LimbVector scratch(scratchSize());
+	multiply(r.data(), r.data(), m_r2.data(), scratch.data());
+	return r;
+}
+
+LimbVector MontgomeryReducer::leave(const LimbVector& a) const
+{
+	const SizeType n = size();
+	LimbVector t(2 * n + 1);
+	std::copy(a.begin(), a.end(), t.begin());
+	LimbVector r(n);
+	reduce(r.data(), t.data());
+	normalize(r);
+	return r;
+}
+
+void MontgomeryReducer::multiply(Limb* r, const Limb* a, const Limb* b, Limb* scratch) const
+{
+	const SizeType n = size();
+	nsLimb::multiply(scratch, a, n, b, n);
+	scratch[2 * n] = 0;
+	reduce(r, scratch);
+}
+
+void MontgomeryReducer::reduce(Limb* r, Limb* t) const
+{
+	const SizeType n = size();
+	const Limb* m = m_modulus.data();
+	for (SizeType i = 0; i < n; ++i)
+	{
+		// q * m clears limb i
+		Limb high{};
+		const Limb q = splitLimb(static_cast<DoubleLimb>(t[i]) * m_inverse, high);
+		const Limb carry = addMulLimb(t + i, m, n, q);
+		addLimb(t + i + n, t + i + n, n + 1 - i, carry);
+	}
+	// t / R is below 2 * m
+	Limb* high = t + n;
+	if (compare(high, n + 1, m, n) >= 0)
+	{
+		sub(high, high, n + 1, m, n);
+	}
+	std::copy(high, high + n, r);
+}
+
+Limb MontgomeryReducer::negatedInverse(const Limb a)
+{
+	// Start right modulo 8 (a * a for odd a) or modulo 10, newton steps x = x * (2 - a * x) double the correct low digits
+	constexpr Limb kDIGIT_INVERSE[10] = { 0, 1, 0, 7, 0, 0, 0, 3, 0, 9 };
+	Limb inverse = kDECIMAL_LIMBS ? kDIGIT_INVERSE[a % 10] : a;
+	for (int i = 0; i < 5; ++i)
+	{
+		Limb high{};
+		const Limb product = splitLimb(static_cast<DoubleLimb>(a) * inverse, high);
+		const Limb twoMinus = static_cast<Limb>((kLIMB_BASE + 2 - product) % kLIMB_BASE);
+		inverse = splitLimb(static_cast<DoubleLimb>(inverse) * twoMinus, high);
+	}
+	return inverse ? static_cast<Limb>(kLIMB_BASE - inverse) : 0;
+}
+
+// base^exp mod m by left to right sliding windows, base is below the modulus and exp is non zero.
+// Reducer gives size(), enter(), leave() and multiply() on residues (ModularReducer, MontgomeryReducer).
+template <typename Reducer>
+inline LimbVector windowedPower(const Reducer& reducer, const LimbVector& base, const LimbVector& exp)
+{
+	const SizeType n = reducer.size();
+	LimbVector words = binaryWords(exp);
+	normalize(words);
+	const unsigned k = powerWindowSize(bitLength(words));
+
+	// Odd powers base^1, base^3, ... base^(2^k - 1)
+	LimbVector scratch(reducer.scratchSize());
+	std::vector<LimbVector> odd(static_cast<SizeType>(1) << (k - 1));
+	odd[0] = reducer.enter(base);
+	if (odd.size() > 1)
+	{
+		LimbVector baseSquare(n);
+		reducer.multiply(baseSquare.data(), odd[0].data(), odd[0].data(), scratch.data());
+		for (SizeType i = 1; i < odd.size(); ++i)
+		{
+			odd[i].resize(n);
+			reducer.multiply(odd[i].data(), odd[i - 1].data(), baseSquare.data(), scratch.data());
+		}
+	}
+
+	LimbVector result;
+	slidingWindows(words, k,
+		[&]() { reducer.multiply(result.data(), result.data(), result.data(), scratch.data()); },
+		[&](const SizeType i)
+		{
+			if (result.empty())
+			{
+				result = odd[i];
+			}
+			else
+			{
+				reducer.multiply(result.data(), result.data(), odd[i].data(), scratch.data());
+			}
+		});
+	return reducer.leave(result);
+}
+
+// base^exp mod modulus, modulus is non zero. Memory stays in the size of the modulus whatever the exponent.
+inline LimbVector powerModulo(const LimbVector& base, const LimbVector& exp, const LimbVector& modulus)
+{
+	const ModularReducer reducer(modulus);
+	LimbVector b(base);
+	reducer.reduce(b);
+	if (isZero(exp))
+	{
+		LimbVector one{ 1 };
+		reducer.reduce(one);
+		return one;
+	}
+	if (MontgomeryReducer::supports(reducer.modulus()) && reducer.size() <= kMONTGOMERY_THRESHOLD)
+	{
+		return windowedPower(MontgomeryReducer(reducer), b, exp);
+	}
+	return windowedPower(reducer, b, exp);
+}
+}	// namespace nsLimb
+}	// namespace nsNumber
+#endif // #ifndef __LIMB_MODULAR_H__
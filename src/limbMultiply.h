@@ -0,0 +1,725 @@
+/*
+	@file	: limbMultiply.h
+	@breif	: Multiplication kernels on limb arrays, schoolbook, karatsuba, toom-cook and ntt, and short products
+*/
+
+#ifndef __LIMB_MULTIPLY_H__
+#define __LIMB_MULTIPLY_H__
+
+#include <vector>
+
+#include "limbArithmetic.h"
+#include "limbNtt.h"
+
+namespace nsNumber
+{
+namespace nsLimb
+{
+// Operand size (in limbs) from where karatsuba beats the schoolbook multiplication
+constexpr SizeType kKARATSUBA_THRESHOLD = 32;
+// Operand sizes (in limbs) from where toom-3 and toom-4 beat the tier below
+constexpr SizeType kTOOM3_THRESHOLD = 300;
+constexpr SizeType kTOOM4_THRESHOLD = 2000;
+// Operand size (in limbs) from where the number theoretic transform beats toom-4
+constexpr SizeType kNTT_THRESHOLD = 14000;
+// Operand size (in limbs) from where karatsuba squaring beats the schoolbook squaring
+constexpr SizeType kSQUARE_KARATSUBA_THRESHOLD = 64;
+// Operand sizes (in limbs) where a short product beats the whole product. Above the upper one the
+// full products inside it run on toom-cook or ntt and leave too little to save.
+constexpr SizeType kSHORT_PRODUCT_THRESHOLD = 8;
+constexpr SizeType kSHORT_PRODUCT_LIMIT = kNTT_THRESHOLD;
+
+inline void multiply(Limb* r, const Limb* a, SizeType an, const Limb* b, SizeType bn);
+inline LimbVector multiply(const LimbVector& a, const LimbVector& b);
+inline void square(Limb* r, const Limb* a, SizeType n);
+inline LimbVector square(const LimbVector& a);
+
+// r = a * b, r has (an + bn) limbs and must not overlap a or b, an >= bn > 0
+inline void longMultiplication(Limb* r, const Limb* a, SizeType an, const Limb* b, SizeType bn)
+{
+	r[an] = mulLimb(r, a, an, b[0]);
+	for (SizeType i = 1; i < bn; ++i)
+	{
+		r[an + i] = addMulLimb(r + i, a, an, b[i]);
+	}
+}
+
+// r = a * a, r has 2n limbs and must not overlap a, n > 0
+// Every product a[i] * a[j] with i != j is computed once and doubled, then the squares are added
+inline void longSquaring(Limb* r, const Limb* a, SizeType n)
+{
+	std::fill(r, r + 2 * n, 0);
+	for (SizeType i = 0; i + 1 < n; ++i)
+	{
+		r[i + n] = addMulLimb(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+	}
+	add(r, r, 2 * n, r, 2 * n);
+
+	Limb carry = 0;
+	for (SizeType i = 0; i < n; ++i)
+	{
+		Limb high{};
+		const Limb low = splitLimb(static_cast<DoubleLimb>(a[i]) * a[i], high);
+		DoubleLimb sum = static_cast<DoubleLimb>(r[2 * i]) + low + carry;
+		carry = (sum >= kLIMB_BASE) ? 1 : 0;
+		r[2 * i] = static_cast<Limb>(carry ? sum - kLIMB_BASE : sum);
+		sum = static_cast<DoubleLimb>(r[2 * i + 1]) + high + carry;
+		carry = (sum >= kLIMB_BASE) ? 1 : 0;
+		r[2 * i + 1] = static_cast<Limb>(carry ? sum - kLIMB_BASE : sum);
+	}
+}
+
+// Limbs of scratch a karatsuba step on operands of up to n limbs needs, every level
+// takes its two sums and z1 and hands the rest down to the products of m2 + 1 limbs
+inline SizeType karatsubaScratchSize(SizeType n)
+{
+	SizeType size = 0;
+	do
+	{
+		const SizeType m2 = (n + 1) / 2;
+		size += 4 * m2 + 4;
+		n = m2 + 1;
+	} while (n >= kKARATSUBA_THRESHOLD);
+	return size;
+}
+
+inline void karatsubaMultiply(Limb* r, const Limb* a, SizeType an, const Limb* b, SizeType bn, Limb* scratch);
+inline void karatsubaSquare(Limb* r, const Limb* a, SizeType n, Limb* scratch);
+
+//function karatsuba(num1, num2)
+//m2 = ceil(size(num1) / 2)
+//high1, low1 = split_at(num1, m2)
+//high2, low2 = split_at(num2, m2)
+//z0 = karatsuba(low1, low2)
+//z1 = karatsuba(low1 + high1, low2 + high2)
+//z2 = karatsuba(high1, high2)
+//return (z2 × B ^ (m2 × 2)) + ((z1 - z2 - z0) × B ^ m2) + z0
+
+// r = a * b, r has (an + bn) limbs and must not overlap a or b, an >= bn > an / 2
+// scratch holds karatsubaScratchSize(an) limbs, nothing is allocated below this call
+inline void karatsubaMultiplication(Limb* r, const Limb* a, SizeType an, const Limb* b, SizeType bn, Limb* scratch)
+{
+	const SizeType m2 = (an + 1) / 2;
+	const Limb* low1 = a;
+	const Limb* high1 = a + m2;
+	const Limb* low2 = b;
+	const Limb* high2 = b + m2;
+	const SizeType high1Size = an - m2;
+	const SizeType high2Size = bn - m2;
+
+	Limb* sum1 = scratch;
+	Limb* sum2 = sum1 + m2 + 1;
+	Limb* z1 = sum2 + m2 + 1;
+	const SizeType z1Capacity = 2 * m2 + 2;
+	Limb* rest = z1 + z1Capacity;
+
+	// z0 and z2 go straight to their final place in r
+	karatsubaMultiply(r, low1, m2, low2, m2, rest);
+	karatsubaMultiply(r + 2 * m2, high1, high1Size, high2, high2Size, rest);
+
+	sum1[m2] = add(sum1, low1, m2, high1, high1Size);
+	sum2[m2] = add(sum2, low2, m2, high2, high2Size);
+
+	karatsubaMultiply(z1, sum1, m2 + 1, sum2, m2 + 1, rest);
+	sub(z1, z1, z1Capacity, r, 2 * m2);
+	sub(z1, z1, z1Capacity, r + 2 * m2, high1Size + high2Size);
+
+	// z1 = low1 * high2 + high1 * low2 always fits in what is left of r above m2
+	const SizeType z1Size = normalizedSize(z1, z1Capacity);
+	add(r + m2, r + m2, an + bn - m2, z1, z1Size);
+}
+
+// r = a * a, r has 2n limbs and must not overlap a, scratch holds karatsubaScratchSize(n) limbs
+// z1 = (low + high)^2 - z0 - z2, so all three products are squares
+inline void karatsubaSquaring(Limb* r, const Limb* a, SizeType n, Limb* scratch)
+{
+	const SizeType m2 = (n + 1) / 2;
+	const SizeType highSize = n - m2;
+
+	Limb* sum = scratch;
+	Limb* z1 = sum + m2 + 1;
+	const SizeType z1Capacity = 2 * m2 + 2;
+	Limb* rest = z1 + z1Capacity;
+
+	karatsubaSquare(r, a, m2, rest);
+	karatsubaSquare(r + 2 * m2, a + m2, highSize, rest);
+
+	sum[m2] = add(sum, a, m2, a + m2, highSize);
+	const SizeType sumSize = normalizedSize(sum, m2 + 1);
+
+	std::fill(z1 + 2 * sumSize, z1 + z1Capacity, 0);
+	karatsubaSquare(z1, sum, sumSize, rest);
+	sub(z1, z1, z1Capacity, r, 2 * m2);
+	sub(z1, z1, z1Capacity, r + 2 * m2, 2 * highSize);
+
+	const SizeType z1Size = normalizedSize(z1, z1Capacity);
+	add(r + m2, r + m2, 2 * n - m2, z1, z1Size);
+}
+
+// r = a * b where an >= 2 * bn, b is multiplied against bn sized slices of a
+// scratch holds 2 * bn limbs for the partial products, followed by what the slice products need
+inline void unbalancedMultiplication(Limb* r, const Limb* a, SizeType an, const Limb* b, SizeType bn, Limb* scratch)
+{
+	std::fill(r, r + an + bn, 0);
+	Limb* partial = scratch;
+	Limb* rest = scratch + 2 * bn;
+	for (SizeType pos = 0; pos < an; pos += bn)
+	{
+		const SizeType count = std::min(bn, an - pos);
+		if (bn < kTOOM3_THRESHOLD)
+		{
+			karatsubaMultiply(partial, a + pos, count, b, bn, rest);
+		}
+		else
+		{
+			multiply(partial, a + pos, count, b, bn);
+		}
+		add(r + pos, r + pos, an + bn - pos, partial, count + bn);
+	}
+}
+
+// r = a * b for operands below the toom-3 range, every temporary comes out of scratch
+// scratch holds karatsubaScratchSize(max(an, bn)) limbs
+inline void karatsubaMultiply(Limb* r, const Limb* a, SizeType an, const Limb* b, SizeType bn, Limb* scratch)
+{
+	if (an < bn)
+	{
+		std::swap(a, b);
+		std::swap(an, bn);
+	}
+	if (bn == 0)
+	{
+		std::fill(r, r + an, 0);
+	}
+	else if (bn < kKARATSUBA_THRESHOLD)
+	{
+		longMultiplication(r, a, an, b, bn);
+	}
+	else if (an >= 2 * bn)
+	{
+		unbalancedMultiplication(r, a, an, b, bn, scratch);
+	}
+	else
+	{
+		karatsubaMultiplication(r, a, an, b, bn, scratch);
+	}
+}
+
+// r = a * a for n below the toom-3 range, scratch holds karatsubaScratchSize(n) limbs
+inline void karatsubaSquare(Limb* r, const Limb* a, SizeType n, Limb* scratch)
+{
+	if (n == 0)
+	{
+		return;
+	}
+	if (n < kSQUARE_KARATSUBA_THRESHOLD)
+	{
+		longSquaring(r, a, n);
+	}
+	else
+	{
+		karatsubaSquaring(r, a, n, scratch);
+	}
+}
+
+
+// Signed magnitude used while interpolating, value = (negative ? -1 : 1) * magnitude
+struct SignedLimbs
+{
+	LimbVector	magnitude;
+	bool		negative{ false };
+};
+
+inline SignedLimbs addSigned(const SignedLimbs& a, const SignedLimbs& b)
+{
+	const LimbVector& big = a.magnitude.size() >= b.magnitude.size() ? a.magnitude : b.magnitude;
+	const LimbVector& small = a.magnitude.size() >= b.magnitude.size() ? b.magnitude : a.magnitude;
+	SignedLimbs result;
+	if (a.negative == b.negative)
+	{
+		result.magnitude.resize(big.size() + 1);
+		result.magnitude[big.size()] = add(result.magnitude.data(), big.data(), big.size(), small.data(), small.size());
+		result.negative = a.negative;
+	}
+	else
+	{
+		const bool aBigger = compare(a.magnitude, b.magnitude) >= 0;
+		const LimbVector& lhs = aBigger ? a.magnitude : b.magnitude;
+		const LimbVector& rhs = aBigger ? b.magnitude : a.magnitude;
+		result.magnitude.resize(lhs.size());
+		sub(result.magnitude.data(), lhs.data(), lhs.size(), rhs.data(), rhs.size());
+		result.negative = aBigger ? a.negative : b.negative;
+	}
+	normalize(result.magnitude);
+	result.negative = result.negative && !result.magnitude.empty();
+	return result;
+}
+
+inline SignedLimbs subSigned(const SignedLimbs& a, SignedLimbs b)
+{
+	b.negative = !b.negative && !b.magnitude.empty();
+	return addSigned(a, b);
+}
+
+// a *= v
+inline void mulSigned(SignedLimbs& a, const Limb v)
+{
+	const Limb carry = mulLimb(a.magnitude.data(), a.magnitude.data(), a.magnitude.size(), v);
+	if (carry)
+	{
+		a.magnitude.push_back(carry);
+	}
+}
+
+// a /= v, the division has to be exact
+inline void divExactSigned(SignedLimbs& a, const Limb v)
+{
+	divRemLimb(a.magnitude.data(), a.magnitude.data(), a.magnitude.size(), v);
+	normalize(a.magnitude);
+}
+
+// a * b, a square when both are the same object
+inline SignedLimbs mulSigned(const SignedLimbs& a, const SignedLimbs& b)
+{
+	SignedLimbs result;
+	result.magnitude = (&a == &b) ? square(a.magnitude) : multiply(a.magnitude, b.magnitude);
+	result.negative = (a.negative != b.negative) && !result.magnitude.empty();
+	return result;
+}
+
+// Splits a into 'count' pieces of k limbs, the last piece takes what is left (possibly nothing)
+inline std::vector<SignedLimbs> toomSplit(const Limb* a, const SizeType an, const SizeType k, const SizeType count)
+{
+	std::vector<SignedLimbs> parts(count);
+	for (SizeType i = 0; i < count; ++i)
+	{
+		const SizeType begin = std::min(i * k, an);
+		const SizeType end = (i + 1 == count) ? an : std::min(begin + k, an);
+		parts[i].magnitude.assign(a + begin, a + end);
+		normalize(parts[i].magnitude);
+	}
+	return parts;
+}
+
+// Horner evaluation of the polynomial with the given pieces at a small point
+inline SignedLimbs toomEvaluate(const std::vector<SignedLimbs>& parts, const int point)
+{
+	SignedLimbs value = parts.back();
+	for (SizeType i = parts.size() - 1; i-- > 0;)
+	{
+		mulSigned(value, static_cast<Limb>(point < 0 ? -point : point));
+		normalize(value.magnitude);
+		value.negative = (value.negative != (point < 0)) && !value.magnitude.empty();
+		value = addSigned(value, parts[i]);
+	}
+	return value;
+}
+
+// Product of both polynomials at a small point, y is not evaluated when squaring
+inline SignedLimbs toomPointProduct(const std::vector<SignedLimbs>& x, const std::vector<SignedLimbs>& y, const int point, const bool squaring)
+{
+	const SignedLimbs px = toomEvaluate(x, point);
+	if (squaring)
+	{
+		return mulSigned(px, px);
+	}
+	return mulSigned(px, toomEvaluate(y, point));
+}
+
+// r = sum of coefficients[i] * B^(i * k), r has rn limbs, every coefficient has to be non negative
+inline void toomRecompose(Limb* r, const SizeType rn, const std::vector<SignedLimbs>& coefficients, const SizeType k)
+{
+	std::fill(r, r + rn, 0);
+	for (SizeType i = 0; i < coefficients.size(); ++i)
+	{
+		const LimbVector& c = coefficients[i].magnitude;
+		if (!c.empty())
+		{
+			add(r + i * k, r + i * k, rn - i * k, c.data(), c.size());
+		}
+	}
+}
+
+// r = a * b, r has (an + bn) limbs and must not overlap a or b, an >= bn > an / 2
+// Toom-3, evaluation at 0, 1, -1, -2 and infinity, interpolation sequence by Bodrato
+inline void toom3Multiplication(Limb* r, const Limb* a, SizeType an, const Limb* b, SizeType bn)
+{
+	const SizeType k = (an + 2) / 3;
+	const bool squaring = (a == b && an == bn);
+	const std::vector<SignedLimbs> x = toomSplit(a, an, k, 3);
+	const std::vector<SignedLimbs> ySplit = squaring ? std::vector<SignedLimbs>() : toomSplit(b, bn, k, 3);
+	const std::vector<SignedLimbs>& y = squaring ? x : ySplit;
+
+	const SignedLimbs r0 = mulSigned(x[0], y[0]);
+	SignedLimbs r1 = toomPointProduct(x, y, 1, squaring);
+	const SignedLimbs rm1 = toomPointProduct(x, y, -1, squaring);
+	const SignedLimbs rm2 = toomPointProduct(x, y, -2, squaring);
+	const SignedLimbs rInf = mulSigned(x[2], y[2]);
+
+	SignedLimbs r3 = subSigned(rm2, r1);
+	divExactSigned(r3, 3);
+	r1 = subSigned(r1, rm1);
+	divExactSigned(r1, 2);
+	SignedLimbs r2 = subSigned(rm1, r0);
+	r3 = subSigned(r2, r3);
+	divExactSigned(r3, 2);
+	SignedLimbs twiceInf = rInf;
+	mulSigned(twiceInf, 2);
+	r3 = addSigned(r3, twiceInf);
+	r2 = subSigned(addSigned(r2, r1), rInf);
+	r1 = subSigned(r1, r3);
+
+	toomRecompose(r, an + bn, { r0, r1, r2, r3, rInf }, k);
+}
+
+// r = a * b, r has (an + bn) limbs and must not overlap a or b, an >= bn > an / 2
+// Toom-4, evaluation at 0, 1, -1, 2, -2, 3 and infinity
+inline void toom4Multiplication(Limb* r, const Limb* a, SizeType an, const Limb* b, SizeType bn)
+{
+	const SizeType k = (an + 3) / 4;
+	const bool squaring = (a == b && an == bn);
+	const std::vector<SignedLimbs> x = toomSplit(a, an, k, 4);
+	const std::vector<SignedLimbs> ySplit = squaring ? std::vector<SignedLimbs>() : toomSplit(b, bn, k, 4);
+	const std::vector<SignedLimbs>& y = squaring ? x : ySplit;
+
+	const SignedLimbs c0 = mulSigned(x[0], y[0]);
+	const SignedLimbs c6 = mulSigned(x[3], y[3]);
+	const SignedLimbs p1 = toomPointProduct(x, y, 1, squaring);
+	const SignedLimbs pm1 = toomPointProduct(x, y, -1, squaring);
+	const SignedLimbs p2 = toomPointProduct(x, y, 2, squaring);
+	const SignedLimbs pm2 = toomPointProduct(x, y, -2, squaring);
+	const SignedLimbs p3 = toomPointProduct(x, y, 3, squaring);
+
+	// Even part, e1 = c2 + c4 and e2 = c2 + 4 * c4
+	SignedLimbs scaled = c6;
+	SignedLimbs e1 = addSigned(p1, pm1);
+	divExactSigned(e1, 2);
+	e1 = subSigned(subSigned(e1, c0), c6);
+	SignedLimbs e2 = addSigned(p2, pm2);
+	divExactSigned(e2, 2);
+	mulSigned(scaled, 64);
+	e2 = subSigned(subSigned(e2, c0), scaled);
+	divExactSigned(e2, 4);
+	SignedLimbs c4 = subSigned(e2, e1);
+	divExactSigned(c4, 3);
+	const SignedLimbs c2 = subSigned(e1, c4);
+
+	// Odd part, o1 = c1 + c3 + c5, o2 = c1 + 4 * c3 + 16 * c5, o3 = c1 + 9 * c3 + 81 * c5
+	SignedLimbs o1 = subSigned(p1, pm1);
+	divExactSigned(o1, 2);
+	SignedLimbs o2 = subSigned(p2, pm2);
+	divExactSigned(o2, 4);
+	SignedLimbs o3 = subSigned(p3, c0);
+	scaled = c2;
+	mulSigned(scaled, 9);
+	o3 = subSigned(o3, scaled);
+	scaled = c4;
+	mulSigned(scaled, 81);
+	o3 = subSigned(o3, scaled);
+	scaled = c6;
+	mulSigned(scaled, 729);
+	o3 = subSigned(o3, scaled);
+	divExactSigned(o3, 3);
+
+	// d1 = c3 + 5 * c5, d2 = c3 + 13 * c5
+	SignedLimbs d1 = subSigned(o2, o1);
+	divExactSigned(d1, 3);
+	SignedLimbs d2 = subSigned(o3, o2);
+	divExactSigned(d2, 5);
+	SignedLimbs c5 = subSigned(d2, d1);
+	divExactSigned(c5, 8);
+	scaled = c5;
+	mulSigned(scaled, 5);
+	const SignedLimbs c3 = subSigned(d1, scaled);
+	const SignedLimbs c1 = subSigned(subSigned(o1, c3), c5);
+
+	toomRecompose(r, an + bn, { c0, c1, c2, c3, c4, c5, c6 }, k);
+}
+
+// r = a * b, r has (an + bn) limbs and must not overlap a or b
+inline void multiply(Limb* r, const Limb* a, SizeType an, const Limb* b, SizeType bn)
+{
+	if (a == b && an == bn)
+	{
+		square(r, a, an);
+		return;
+	}
+	if (an < bn)
+	{
+		std::swap(a, b);
+		std::swap(an, bn);
+	}
+	if (bn == 0)
+	{
+		std::fill(r, r + an, 0);
+	}
+	else if (bn < kKARATSUBA_THRESHOLD)
+	{
+		longMultiplication(r, a, an, b, bn);
+	}
+	else if (bn >= kNTT_THRESHOLD && an + bn <= (static_cast<SizeType>(1) << kNTT_MAX_LOG))
+	{
+		nttMultiplication(r, a, an, b, bn);
+	}
+	else if (an >= 2 * bn)
+	{
+		// One scratch arena serves every slice product
+		LimbVector scratch(2 * bn + (bn < kTOOM3_THRESHOLD ? karatsubaScratchSize(bn) : 0));
+		unbalancedMultiplication(r, a, an, b, bn, scratch.data());
+	}
+	else if (bn < kTOOM3_THRESHOLD)
+	{
+		// The whole recursion runs in one arena sized up front
+		LimbVector scratch(karatsubaScratchSize(an));
+		karatsubaMultiplication(r, a, an, b, bn, scratch.data());
+	}
+	else if (bn < kTOOM4_THRESHOLD)
+	{
+		toom3Multiplication(r, a, an, b, bn);
+	}
+	else
+	{
+		toom4Multiplication(r, a, an, b, bn);
+	}
+}
+
+inline LimbVector multiply(const LimbVector& a, const LimbVector& b)
+{
+	const SizeType an = normalizedSize(a.data(), a.size());
+	const SizeType bn = normalizedSize(b.data(), b.size());
+	LimbVector r;
+	if (an == 0 || bn == 0)
+	{
+		return r;
+	}
+	r.resize(an + bn);
+	multiply(r.data(), a.data(), an, b.data(), bn);
+	normalize(r);
+	return r;
+}
+
+// r = a * a, r has 2n limbs and must not overlap a
+inline void square(Limb* r, const Limb* a, SizeType n)
+{
+	if (n == 0)
+	{
+		return;
+	}
+	if (n < kSQUARE_KARATSUBA_THRESHOLD)
+	{
+		longSquaring(r, a, n);
+	}
+	else if (n >= kNTT_THRESHOLD && 2 * n <= (static_cast<SizeType>(1) << kNTT_MAX_LOG))
+	{
+		nttMultiplication(r, a, n, a, n);
+	}
+	else if (n < kTOOM3_THRESHOLD)
+	{
+		LimbVector scratch(karatsubaScratchSize(n));
+		karatsubaSquaring(r, a, n, scratch.data());
+	}
+	else if (n < kTOOM4_THRESHOLD)
+	{
+		toom3Multiplication(r, a, n, a, n);
+	}
+	else
+	{
+		toom4Multiplication(r, a, n, a, n);
+	}
+}
+
+inline LimbVector square(const LimbVector& a)
+{
+	const SizeType n = normalizedSize(a.data(), a.size());
+	LimbVector r;
+	if (n == 0)
+	{
+		return r;
+	}
+	r.resize(2 * n);
+	square(r.data(), a.data(), n);
+	normalize(r);
+	return r;
+}
+
+// Short product of n limb operands, r has 2n limbs and must not overlap a or b. Every partial product
+// a[i] * b[j] with i + j >= n - 1 goes into r, some of the lower ones too, so r <= a * b < r + n * base^n.
+// Above the schoolbook sizes the top k limbs of a and b make a full product and the two strips left
+// over are short products of n - k limbs (Mulders), k = 0.7 n suits karatsuba best.
+inline void shortProduct(Limb* r, const Limb* a, const Limb* b, const SizeType n)
+{
+	std::fill(r, r + 2 * n, 0);
+	if (n < kKARATSUBA_THRESHOLD)
+	{
+		for (SizeType i = 0; i < n; ++i)
+		{
+			r[n + i] = addMulLimb(r + n - 1, b + n - 1 - i, i + 1, a[i]);
+		}
+		return;
+	}
+
+	const SizeType l = n * 3 / 10;
+	const SizeType k = n - l;
+	multiply(r + 2 * l, a + l, k, b + l, k);
+	LimbVector strip(2 * l);
+	shortProduct(strip.data(), a, b + k, l);
+	add(r + k, r + k, n + l, strip.data(), strip.size());
+	if (a != b)
+	{
+		shortProduct(strip.data(), b, a + k, l);
+	}
+	add(r + k, r + k, n + l, strip.data(), strip.size());
+}
+
+// High limbs of a * b for callers that can live with an error below base^error. Returns false when
+// a short product would save nothing, otherwise high and shift with
+// high * base^shift <= a * b < high * base^shift + base^error.
+// Operands of different sizes, or an error that reaches below the middle of the product, are padded
+// with low zero limbs up to the common size m of a short product that is accurate enough.
+inline bool shortMultiply(const LimbVector& a, const LimbVector& b, const SizeType error, LimbVector& high, SizeType& shift)
+{
+	const SizeType an = normalizedSize(a.data(), a.size());
+	const SizeType bn = normalizedSize(b.data(), b.size());
+	const SizeType shorter = std::min(an, bn);
+	if (shorter < kSHORT_PRODUCT_THRESHOLD || error < 2)
+	{
+		return false;
+	}
+	// The error stays below (m + 1) base^(an + bn - m) <= base^(an + bn - m + 1)
+	const SizeType m = std::max(an, bn) + (shorter + 1 > error ? shorter + 1 - error : 0);
+	const SizeType padding = 2 * m - an - bn;
+	if (m >= kSHORT_PRODUCT_LIMIT || padding > m / 4)
+	{
+		return false;
+	}
+
+	LimbVector x(m, 0);
+	std::copy(a.begin(), a.begin() + an, x.begin() + (m - an));
+	LimbVector y;
+	if (&a != &b)
+	{
+		y.resize(m, 0);
+		std::copy(b.begin(), b.begin() + bn, y.begin() + (m - bn));
+	}
+	LimbVector r(2 * m);
+	shortProduct(r.data(), x.data(), y.empty() ? x.data() : y.data(), m);
+
+	// Limbs below m - 1 only hold some of their partial products and are dropped
+	high.assign(r.begin() + (m - 1), r.end());
+	normalize(high);
+	shift = an + bn - m - 1;
+	return true;
+}
+
+// Window width for an exponent of that many bits, balancing the 2^(k - 1) table entries against
+// the bits / (k + 1) multiplications the scan needs
+inline unsigned powerWindowSize(const SizeType bits)
+{
+	constexpr SizeType kWINDOW_LIMITS[] = { 7, 25, 80, 240, 672, 1792 };
+	unsigned k = 1;
+	while (k <= 6 && bits > kWINDOW_LIMITS[k - 1])
+	{
+		k++;
+	}
+	return k;
+}
+
+// Left to right sliding windows over the bits of words (non zero), each window has at most k bits
+// and ends in a set bit. multiply(i) asks for the running power times base^(2i + 1), the first call
+// starts it. square() follows once per bit after that first window.
+template <typename Square, typename Multiply>
+inline void slidingWindows(const LimbVector& words, const unsigned k, Square square, Multiply multiply)
+{
+	const auto bit = [&words](const SizeType i) { return (words[i / kLIMB_BITS] >> (i % kLIMB_BITS)) & 1; };
+	bool started = false;
+	for (SizeType i = bitLength(words); i-- > 0;)
+	{
+		if (!bit(i))
+		{
+			square();
+			continue;
+		}
+		SizeType low = i + 1 > k ? i + 1 - k : 0;
+		while (!bit(low))
+		{
+			low++;
+		}
+		SizeType window = 0;
+		for (SizeType j = i + 1; j-- > low;)
+		{
+			window = 2 * window + bit(j);
+		}
+		for (SizeType j = low; started && j <= i; ++j)
+		{
+			square();
+		}
+		multiply(window / 2);
+		started = true;
+		i = low;
+	}
+}
+
+// base^exp, exp is non zero
+inline LimbVector power(const LimbVector& base, const LimbVector& exp)
+{
+	LimbVector words = binaryWords(exp);
+	normalize(words);
+	const SizeType bn = normalizedSize(base.data(), base.size());
+	if (bn == 0)
+	{
+		return LimbVector();
+	}
+
+	// Small powers in native 128 bit arithmetic
+	if (bn == 1 && words.size() == 1 && words[0] < 2 * kLIMB_BITS)
+	{
+		DoubleLimb val = 1;
+		DoubleLimb factor = base[0];
+		bool overflow = false;
+		for (Limb e = words[0]; e && !overflow; e >>= 1)
+		{
+			overflow = ((e & 1) && __builtin_mul_overflow(val, factor, &val)) || (e > 1 && __builtin_mul_overflow(factor, factor, &factor));
+		}
+		if (!overflow)
+		{
+			LimbVector result;
+			fromDoubleLimb(val, result);
+			return result;
+		}
+	}
+
+	// A power of two on binary limbs is a single bit
+	if (!kDECIMAL_LIMBS && words.size() == 1 && (base[bn - 1] & (base[bn - 1] - 1)) == 0 && normalizedSize(base.data(), bn - 1) == 0)
+	{
+		const SizeType log2 = (bn - 1) * kLIMB_BITS + (kLIMB_BITS - 1 - countLeadingZeros(base[bn - 1]));
+		SizeType shift{};
+		if (!__builtin_mul_overflow(log2, words[0], &shift))
+		{
+			LimbVector result(shift / kLIMB_BITS + 1);
+			result.back() = static_cast<Limb>(1) << (shift % kLIMB_BITS);
+			return result;
+		}
+	}
+
+	const unsigned k = powerWindowSize(bitLength(words));
+	std::vector<LimbVector> odd(static_cast<SizeType>(1) << (k - 1));
+	odd[0] = base;
+	normalize(odd[0]);
+	if (odd.size() > 1)
+	{
+		const LimbVector baseSquare = square(odd[0]);
+		for (SizeType i = 1; i < odd.size(); ++i)
+		{
+			odd[i] = multiply(odd[i - 1], baseSquare);
+		}
+	}
+
+	LimbVector result;
+	slidingWindows(words, k,
+		[&]() { result = square(result); },
+		[&](const SizeType i) { result = result.empty() ? odd[i] : multiply(result, odd[i]); });
+	return result;
+}
+}	// namespace nsLimb
+}	// namespace nsNumber
+#endif // #ifndef __LIMB_MULTIPLY_H__
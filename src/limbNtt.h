@@ -0,0 +1,256 @@
+/*
+	@file	: limbNtt.h
+	@breif	: Number theoretic transform multiplication on limb arrays
+
+	@NOTE	: Limbs are convolved modulo three primes below 2^63 and the exact
+			  coefficients are rebuilt with the chinese remainder theorem. The
+			  product of the primes is above 2^183, which covers coefficients of
+			  transforms up to 2^55 points.
+*/
+
+#ifndef __LIMB_NTT_H__
+#define __LIMB_NTT_H__
+
+#include <vector>
+
+#include "limbArithmetic.h"
+
+namespace nsNumber
+{
+namespace nsLimb
+{
+// Arithmetic modulo a prime p < 2^63 with the values kept in montgomery form (a * 2^64 mod p)
+class MontgomeryPrime
+{
+public:
+	constexpr explicit MontgomeryPrime(const Limb prime, const Limb primitiveRoot)
+		: m_prime(prime)
+		, m_inverse(negatedInverse(prime))
+		, m_r2(static_cast<Limb>(static_cast<DoubleLimb>((0 - prime) % prime) * ((0 - prime) % prime) % prime))
+		, m_primitiveRoot(primitiveRoot)
+	{}
+
+	inline Limb prime() const { return m_prime; }
+	inline Limb primitiveRoot() const { return m_primitiveRoot; }
+
+	inline Limb multiply(const Limb a, const Limb b) const
+	{
+		const DoubleLimb t = static_cast<DoubleLimb>(a) * b;
+		const Limb m = static_cast<Limb>(t) * m_inverse;
+		const Limb r = static_cast<Limb>((t + static_cast<DoubleLimb>(m) * m_prime) >> kLIMB_BITS);
+		return r >= m_prime ? r - m_prime : r;
+	}
+	inline Limb add(const Limb a, const Limb b) const { const Limb r = a + b; return r >= m_prime ? r - m_prime : r; }
+	inline Limb sub(const Limb a, const Limb b) const { return a >= b ? a - b : a + m_prime - b; }
+
+	inline Limb toMontgomery(const Limb a) const { return multiply(a % m_prime, m_r2); }
+	inline Limb fromMontgomery(const Limb a) const { return multiply(a, 1); }
+
+	// base^exp, base and result in montgomery form
+	inline Limb power(Limb base, Limb exp) const
+	{
+		Limb result = toMontgomery(1);
+		while (exp)
+		{
+			if (exp & 1)
+			{
+				result = multiply(result, base);
+			}
+			base = multiply(base, base);
+			exp >>= 1;
+		}
+		return result;
+	}
+
+private:
+	// -p^-1 mod 2^64 by newton iteration, every step doubles the correct bits
+	static constexpr Limb negatedInverse(const Limb prime)
+	{
+		Limb inverse = prime;
+		for (int i = 0; i < 5; ++i)
+		{
+			inverse *= 2 - prime * inverse;
+		}
+		return 0 - inverse;
+	}
+
+private:
+	Limb	m_prime;
+	Limb	m_inverse;
+	Limb	m_r2;
+	Limb	m_primitiveRoot;
+};
+
+constexpr MontgomeryPrime kNTT_PRIMES[3] = {
+	MontgomeryPrime(4179340454199820289ULL, 3),		// 29 * 2^57 + 1
+	MontgomeryPrime(2485986994308513793ULL, 5),		// 69 * 2^55 + 1
+	MontgomeryPrime(1945555039024054273ULL, 5)		// 27 * 2^56 + 1
+};
+constexpr unsigned kNTT_MAX_LOG = 55;
+
+// In place transform of a.size() (a power of two) values in montgomery form, natural order in and out
+inline void transform(std::vector<Limb>& a, const MontgomeryPrime& mod, const bool inverse)
+{
+	const SizeType n = a.size();
+	for (SizeType i = 1, j = 0; i < n; ++i)
+	{
+		SizeType bit = n >> 1;
+		for (; j & bit; bit >>= 1)
+		{
+			j ^= bit;
+		}
+		j ^= bit;
+		if (i < j)
+		{
+			std::swap(a[i], a[j]);
+		}
+	}
+
+	// Powers of the n-th root of unity, shorter stages take every (n / len)-th of them
+	Limb root = mod.power(mod.toMontgomery(mod.primitiveRoot()), (mod.prime() - 1) / n);
+	if (inverse)
+	{
+		root = mod.power(root, mod.prime() - 2);
+	}
+	std::vector<Limb> twiddles(std::max<SizeType>(n / 2, 1));
+	twiddles[0] = mod.toMontgomery(1);
+	for (SizeType k = 1; k < n / 2; ++k)
+	{
+		twiddles[k] = mod.multiply(twiddles[k - 1], root);
+	}
+
+	for (SizeType len = 2; len <= n; len <<= 1)
+	{
+		const SizeType half = len / 2;
+		const SizeType stride = n / len;
+		for (SizeType i = 0; i < n; i += len)
+		{
+			for (SizeType k = 0; k < half; ++k)
+			{
+				const Limb u = a[i + k];
+				const Limb v = mod.multiply(a[i + k + half], twiddles[k * stride]);
+				a[i + k] = mod.add(u, v);
+				a[i + k + half] = mod.sub(u, v);
+			}
+		}
+	}
+
+	if (inverse)
+	{
+		const Limb scale = mod.power(mod.toMontgomery(n % mod.prime()), mod.prime() - 2);
+		for (Limb& val : a)
+		{
+			val = mod.multiply(val, scale);
+		}
+	}
+}
+
+// Cyclic convolution of a and b modulo one prime, plain (not montgomery) residues out
+inline std::vector<Limb> convolution(const Limb* a, SizeType an, const Limb* b, SizeType bn, const SizeType n, const MontgomeryPrime& mod)
+{
+	std::vector<Limb> fa(n, 0);
+	for (SizeType i = 0; i < an; ++i)
+	{
+		fa[i] = mod.toMontgomery(a[i]);
+	}
+	transform(fa, mod, false);
+	if (a == b && an == bn)
+	{
+		for (Limb& val : fa)
+		{
+			val = mod.multiply(val, val);
+		}
+	}
+	else
+	{
+		std::vector<Limb> fb(n, 0);
+		for (SizeType i = 0; i < bn; ++i)
+		{
+			fb[i] = mod.toMontgomery(b[i]);
+		}
+		transform(fb, mod, false);
+		for (SizeType i = 0; i < n; ++i)
+		{
+			fa[i] = mod.multiply(fa[i], fb[i]);
+		}
+	}
+	transform(fa, mod, true);
+	for (Limb& val : fa)
+	{
+		val = mod.fromMontgomery(val);
+	}
+	return fa;
+}
+
+// r = a * b, r has (an + bn) limbs and must not overlap a or b, an + bn <= 2^kNTT_MAX_LOG
+inline void nttMultiplication(Limb* r, const Limb* a, SizeType an, const Limb* b, SizeType bn)
+{
+	SizeType n = 1;
+	while (n < an + bn - 1)
+	{
+		n <<= 1;
+	}
+	const std::vector<Limb> r0 = convolution(a, an, b, bn, n, kNTT_PRIMES[0]);
+	const std::vector<Limb> r1 = convolution(a, an, b, bn, n, kNTT_PRIMES[1]);
+	const std::vector<Limb> r2 = convolution(a, an, b, bn, n, kNTT_PRIMES[2]);
+
+	// Garner constants, kept in montgomery form so that multiplying a plain residue gives a plain residue
+	const MontgomeryPrime& m1 = kNTT_PRIMES[1];
+	const MontgomeryPrime& m2 = kNTT_PRIMES[2];
+	const Limb p0 = kNTT_PRIMES[0].prime();
+	const Limb p1 = m1.prime();
+	const Limb p2 = m2.prime();
+	const Limb inv01 = m1.power(m1.toMontgomery(p0), p1 - 2);		// p0^-1 mod p1
+	const Limb inv02 = m2.power(m2.toMontgomery(p0), p2 - 2);		// p0^-1 mod p2
+	const Limb inv12 = m2.power(m2.toMontgomery(p1), p2 - 2);		// p1^-1 mod p2
+	const DoubleLimb p01 = static_cast<DoubleLimb>(p0) * p1;
+
+	// Running carry as three binary words
+	Limb carry[3] = { 0, 0, 0 };
+	const SizeType rn = an + bn;
+	for (SizeType i = 0; i < rn; ++i)
+	{
+		Limb coefficient[3] = { 0, 0, 0 };
+		if (i + 1 < rn)
+		{
+			// x = v0 + v1 * p0 + v2 * p0 * p1
+			const Limb v0 = r0[i];
+			const Limb v1 = m1.multiply(m1.sub(r1[i], v0 % p1), inv01);
+			const Limb t = m2.multiply(m2.sub(r2[i], v0 % p2), inv02);
+			const Limb v2 = m2.multiply(m2.sub(t, v1 % p2), inv12);
+
+			const DoubleLimb low = static_cast<DoubleLimb>(v1) * p0 + v0;
+			const DoubleLimb mid = static_cast<DoubleLimb>(v2) * static_cast<Limb>(p01);
+			const DoubleLimb high = static_cast<DoubleLimb>(v2) * static_cast<Limb>(p01 >> kLIMB_BITS);
+			DoubleLimb acc = static_cast<DoubleLimb>(static_cast<Limb>(low)) + static_cast<Limb>(mid);
+			coefficient[0] = static_cast<Limb>(acc);
+			acc = (acc >> kLIMB_BITS) + (low >> kLIMB_BITS) + (mid >> kLIMB_BITS) + static_cast<Limb>(high);
+			coefficient[1] = static_cast<Limb>(acc);
+			coefficient[2] = static_cast<Limb>((acc >> kLIMB_BITS) + (high >> kLIMB_BITS));
+		}
+
+		// carry += coefficient
+		DoubleLimb acc = static_cast<DoubleLimb>(carry[0]) + coefficient[0];
+		carry[0] = static_cast<Limb>(acc);
+		acc = (acc >> kLIMB_BITS) + carry[1] + coefficient[1];
+		carry[1] = static_cast<Limb>(acc);
+		carry[2] += static_cast<Limb>(acc >> kLIMB_BITS) + coefficient[2];
+
+#ifdef BIGNUMBER_DECIMAL_LIMBS
+		// Peel one base 10^19 digit off the binary carry
+		Limb rem = 0;
+		carry[2] = kRADIX_DIVISOR.divide(0, carry[2], rem);
+		carry[1] = kRADIX_DIVISOR.divide(rem, carry[1], rem);
+		carry[0] = kRADIX_DIVISOR.divide(rem, carry[0], rem);
+		r[i] = rem;
+#else
+		r[i] = carry[0];
+		carry[0] = carry[1];
+		carry[1] = carry[2];
+		carry[2] = 0;
+#endif
+	}
+}
+}	// namespace nsLimb
+}	// namespace nsNumber
+#endif // #ifndef __LIMB_NTT_H__
@@ -0,0 +1,233 @@
+/*
+	@file	: limbRoot.h
+	@breif	: Integer n-th roots on limb arrays
+
+	@NOTE	: The root of the leading limbs, found recursively, is lifted with newton steps,
+			  so every step only runs at about twice the precision of the one before.
+			  Perfect power tests first look at residues modulo small numbers, which rule
+			  out most values before any root is taken.
+*/
+
+#ifndef __LIMB_ROOT_H__
+#define __LIMB_ROOT_H__
+
+#include <array>
+#include <cmath>
+
+#include "limbArithmetic.h"
+#include "limbMultiply.h"
+#include "limbDivide.h"
+
+namespace nsNumber
+{
+namespace nsLimb
+{
+// Newton steps x = ((n - 1) * x + a / x^(n - 1)) / n from any x >= floor(a^(1/n)). The integer steps
+// keep x above the root and strictly decrease it until they reach floor(a^(1/n)), which is returned.
+// From a good estimate one step lands on the root, checking x^n <= a saves the step that confirms it.
+inline LimbVector rootNewton(const LimbVector& a, const Limb n, LimbVector x)
+{
+	const LimbVector exp{ n - 1 };
+	const LimbVector degree{ n };
+	while (true)
+	{
+		LimbVector quotient;
+		LimbVector remainder;
+		divideAsIntegers(a, n == 2 ? x : power(x, exp), quotient, remainder);
+
+		LimbVector y(std::max(x.size(), quotient.size()) + 1);
+		y[x.size()] = mulLimb(y.data(), x.data(), x.size(), n - 1);
+		add(y.data(), y.data(), y.size(), quotient.data(), quotient.size());
+		divRemLimb(y.data(), y.data(), y.size(), n);
+		normalize(y);
+		if (compare(y, x) >= 0)
+		{
+			return x;
+		}
+		if (compare(n == 2 ? square(y) : power(y, degree), a) <= 0)
+		{
+			return y;
+		}
+		x.swap(y);
+	}
+}
+
+// log2(a) from the two leading limbs, a is non zero. The relative error stays near the double precision.
+inline double log2Estimate(const LimbVector& a)
+{
+	const SizeType an = normalizedSize(a.data(), a.size());
+	const double lead = static_cast<double>(a[an - 1]) * (an > 1 ? static_cast<double>(kLIMB_BASE) : 1.0) + (an > 1 ? static_cast<double>(a[an - 2]) : 0.0);
+	return std::log2(lead) + (an > 2 ? static_cast<double>(an - 2) * std::log2(static_cast<double>(kLIMB_BASE)) : 0.0);
+}
+
+// floor(a^(1/n)) for n >= 2
+inline LimbVector root(const LimbVector& a, const Limb n)
+{
+	const SizeType an = normalizedSize(a.data(), a.size());
+	if (an == 0)
+	{
+		return LimbVector();
+	}
+
+	// The root has at most rootSize limbs
+	const SizeType rootSize = (an + n - 1) / n;
+	if (rootSize > 1)
+	{
+		// Root of the top limbs, then (top root + 1) * base^half is above the root of a
+		const SizeType half = rootSize / 2;
+		const LimbVector top = root(LimbVector(a.data() + n * half, a.data() + an), n);
+		LimbVector x(half, 0);
+		x.insert(x.end(), top.size() + 1, 0);
+		x[half + top.size()] = addLimb(x.data() + half, top.data(), top.size(), 1);
+		normalize(x);
+		return rootNewton(a, n, x);
+	}
+
+	// Single limb root, estimated in floating point
+	const double log2 = log2Estimate(a);
+	if (log2 < static_cast<double>(n) - 1.0)
+	{
+		// a < 2^n
+		return LimbVector{ 1 };
+	}
+	const double estimate = std::exp2(log2 / static_cast<double>(n)) * (1.0 + 1e-9) + 2.0;
+	LimbVector x{ estimate < static_cast<double>(kLIMB_MAX) ? static_cast<Limb>(estimate) : kLIMB_MAX };
+	if (compare(power(x, LimbVector{ n }), a) < 0)
+	{
+		x[0] = kLIMB_MAX;
+	}
+	return rootNewton(a, n, x);
+}
+
+// floor(sqrt(a)), remainder = a - root^2
+inline LimbVector sqrtRem(const LimbVector& a, LimbVector& remainder)
+{
+	LimbVector s = root(a, 2);
+	const LimbVector s2 = square(s);
+	remainder = a;
+	normalize(remainder);
+	sub(remainder.data(), remainder.data(), remainder.size(), s2.data(), s2.size());
+	normalize(remainder);
+	return s;
+}
+
+// true when r is a square modulo kMODULUS
+template <Limb kMODULUS>
+inline bool isSquareResidue(const Limb r)
+{
+	static const std::array<bool, kMODULUS> kSQUARES = []()
+	{
+		std::array<bool, kMODULUS> squares{};
+		for (Limb x = 0; x < kMODULUS; ++x)
+		{
+			squares[x * x % kMODULUS] = true;
+		}
+		return squares;
+	}();
+	return kSQUARES[r % kMODULUS];
+}
+
+// Squares are squares modulo 64, 63, 65 and 11, only about 1 in 100 other values pass all four
+inline bool maybeSquare(const LimbVector& a)
+{
+	const Limb r = modLimb(a.data(), normalizedSize(a.data(), a.size()), 64 * 63 * 65 * 11);
+	return isSquareResidue<64>(r) && isSquareResidue<63>(r) && isSquareResidue<65>(r) && isSquareResidue<11>(r);
+}
+
+// Trial division, for the small moduli of the power filters
+inline bool isSmallPrime(const Limb q)
+{
+	if (q < 4)
+	{
+		return q >= 2;
+	}
+	if ((q & 1) == 0)
+	{
+		return false;
+	}
+	for (Limb d = 3; d * d <= q; d += 2)
+	{
+		if (q % d == 0)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// b^e mod q for q < 2^32
+inline Limb powerModuloSmall(Limb b, Limb e, const Limb q)
+{
+	Limb result = 1 % q;
+	b %= q;
+	for (; e; e >>= 1)
+	{
+		if (e & 1)
+		{
+			result = result * b % q;
+		}
+		b = b * b % q;
+	}
+	return result;
+}
+
+// k-th powers for an odd prime k: modulo a prime q = 1 (mod k) only one in k non zero residues is a
+// k-th power, which is the case when r^((q - 1) / k) = 1. Three such primes pass about 1 in k^3 values.
+inline bool maybePower(const LimbVector& a, const Limb k)
+{
+	constexpr int kFILTER_PRIMES = 3;
+	constexpr Limb kFILTER_LIMIT = static_cast<Limb>(1) << 32;
+	const SizeType an = normalizedSize(a.data(), a.size());
+	int checked = 0;
+	for (Limb q = 2 * k + 1; checked < kFILTER_PRIMES && q < kFILTER_LIMIT; q += 2 * k)
+	{
+		if (!isSmallPrime(q))
+		{
+			continue;
+		}
+		const Limb r = modLimb(a.data(), an, q);
+		if (r != 0 && powerModuloSmall(r, (q - 1) / k, q) != 1)
+		{
+			return false;
+		}
+		checked++;
+	}
+	return true;
+}
+
+// true when a = r^k for some integer r and k >= 2 (k odd when oddOnly), 0 and 1 are powers
+inline bool isPerfectPower(const LimbVector& a, const bool oddOnly)
+{
+	const SizeType an = normalizedSize(a.data(), a.size());
+	if (an == 0 || (an == 1 && a[0] == 1))
+	{
+		return true;
+	}
+	if (!oddOnly && maybeSquare(a) && compare(square(root(a, 2)), a) == 0)
+	{
+		return true;
+	}
+	// Only prime exponents need to be tried, up to the bit length where every root is 1
+	const double bits = log2Estimate(a);
+	for (Limb k = 3; static_cast<double>(k) <= bits; k += 2)
+	{
+		if (!isSmallPrime(k))
+		{
+			continue;
+		}
+		// A root below 2^20 is known to far better than 10^-6 in floating point, it has to be that close to an integer
+		const double estimate = std::exp2(bits / static_cast<double>(k));
+		if (estimate < 1048576.0 && std::fabs(estimate - std::round(estimate)) > 1e-6)
+		{
+			continue;
+		}
+		if (maybePower(a, k) && compare(power(root(a, k), LimbVector{ k }), a) == 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+}	// namespace nsLimb
+}	// namespace nsNumber
+#endif // #ifndef __LIMB_ROOT_H__
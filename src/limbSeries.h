@@ -0,0 +1,151 @@
+/*
+	@file	: limbSeries.h
+	@breif	: Binary splitting of series with rational terms on limb arrays
+
+	@NOTE	: A sum of N terms, each the one before times p(k) / q(k), is folded pairwise into
+			  integers P, Q and T with the sum equal to T / Q. The operands double in size at every
+			  level, so most of the work lands in a few large multiplications. The two halves of
+			  a range, and the products of a large merge, run on separate threads when there are
+			  cores to spare.
+*/
+
+#ifndef __LIMB_SERIES_H__
+#define __LIMB_SERIES_H__
+
+#include <future>
+#include <thread>
+
+#include "limbArithmetic.h"
+#include "limbMultiply.h"
+#include "radixConversion.h"
+
+namespace nsNumber
+{
+namespace nsLimb
+{
+// Ranges with fewer terms are not worth a thread
+constexpr SizeType kPARALLEL_TERMS = 512;
+// Merge products below this size (in limbs) are not worth a thread
+constexpr SizeType kPARALLEL_LIMBS = 2000;
+
+// Products of p(k) and q(k) over a range of terms, and T with sum / Q for the sum of the range where
+// term k is a(k) times the product of p(j) / q(j) from the start of the range up to k.
+// P and T carry a sign, Q is positive.
+struct SeriesSplit
+{
+	LimbVector	P;
+	LimbVector	Q;
+	LimbVector	T;
+	bool		negativeP{};
+	bool		negativeT{};
+};
+
+// Threads the product trees may use
+inline unsigned seriesThreads()
+{
+	return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// a = a + b on signed magnitudes
+inline void addSigned(LimbVector& a, bool& aNegative, const LimbVector& b, const bool bNegative)
+{
+	if (aNegative == bNegative)
+	{
+		a.resize(std::max(a.size(), b.size()) + 1);
+		add(a.data(), a.data(), a.size(), b.data(), b.size());
+	}
+	else if (compare(a, b) >= 0)
+	{
+		sub(a.data(), a.data(), a.size(), b.data(), b.size());
+	}
+	else
+	{
+		LimbVector difference(b);
+		sub(difference.data(), difference.data(), difference.size(), a.data(), a.size());
+		a.swap(difference);
+		aNegative = bNegative;
+	}
+	normalize(a);
+	aNegative = aNegative && !a.empty();
+}
+
+// Right range folded into the left one, P = P1 P2, Q = Q1 Q2, T = T1 Q2 + P1 T2.
+// P is left empty when needP is false, the top of a tree only needs T and Q.
+inline void mergeSplit(SeriesSplit& left, const SeriesSplit& right, const bool needP, const unsigned threads)
+{
+	std::future<void> products;
+	const auto multiplyPQ = [&]()
+	{
+		left.Q = multiply(left.Q, right.Q);
+	};
+	if (threads > 1 && left.Q.size() + right.Q.size() >= kPARALLEL_LIMBS)
+	{
+		products = std::async(std::launch::async, multiplyPQ);
+	}
+	else
+	{
+		multiplyPQ();
+	}
+
+	LimbVector t = multiply(left.T, right.Q);
+	bool negativeT = left.negativeT;
+	addSigned(t, negativeT, multiply(left.P, right.T), left.negativeP != right.negativeT);
+	if (needP)
+	{
+		left.P = multiply(left.P, right.P);
+		left.negativeP = left.negativeP != right.negativeP && !left.P.empty();
+	}
+	else
+	{
+		left.P.clear();
+	}
+	if (products.valid())
+	{
+		products.get();
+	}
+	left.T.swap(t);
+	left.negativeT = negativeT;
+}
+
+// Binary splitting over the terms [a, b), leaf(k, split) fills P = p(k), Q = q(k) and T = a(k) p(k)
+template <typename Leaf>
+inline SeriesSplit binarySplit(const Leaf& leaf, const SizeType a, const SizeType b, const bool needP, const unsigned threads)
+{
+	if (b - a == 1)
+	{
+		SeriesSplit split;
+		leaf(a, split);
+		return split;
+	}
+
+	const SizeType mid = a + (b - a) / 2;
+	if (threads > 1 && b - a >= kPARALLEL_TERMS)
+	{
+		// Both halves cost about the same, each gets half of the threads
+		std::future<SeriesSplit> right = std::async(std::launch::async, [&]() { return binarySplit(leaf, mid, b, needP, threads / 2); });
+		SeriesSplit left = binarySplit(leaf, a, mid, true, threads - threads / 2);
+		mergeSplit(left, right.get(), needP, threads);
+		return left;
+	}
+	SeriesSplit left = binarySplit(leaf, a, mid, true, 1);
+	mergeSplit(left, binarySplit(leaf, mid, b, needP, 1), needP, 1);
+	return left;
+}
+
+// Terms u^k / (k! 10^(digits k)) of exp(u / 10^digits) for k in [a, b), so p(k) = u and q(k) = k 10^digits
+inline SeriesSplit expSplit(const LimbVector& u, const SizeType digits, const SizeType a, const SizeType b)
+{
+	const LimbVector scale = pow10(digits);
+	const auto leaf = [&](const SizeType k, SeriesSplit& split)
+	{
+		split.P = u;
+		split.Q = scale;
+		split.Q.push_back(mulLimb(split.Q.data(), split.Q.data(), split.Q.size(), static_cast<Limb>(k)));
+		normalize(split.Q);
+		split.T = u;
+	};
+	return binarySplit(leaf, a, b, false, seriesThreads());
+}
+}	// namespace nsLimb
+}	// namespace nsNumber
+#endif // #ifndef __LIMB_SERIES_H__
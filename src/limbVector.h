@@ -0,0 +1,190 @@
+/*
+	@file	: limbVector.h
+	@breif	: Growable array of limbs with small buffer optimization
+
+	@NOTE	: Up to kINLINE_LIMBS limbs (128 bits) are kept inside the object itself,
+			  the heap is only touched once a value outgrows that. A borrowed vector reads
+			  limbs owned elsewhere, such as a mapped file, and copies them once it grows.
+*/
+
+#ifndef __LIMB_VECTOR_H__
+#define __LIMB_VECTOR_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <initializer_list>
+#include <utility>
+
+namespace nsNumber
+{
+namespace nsLimb
+{
+class LimbVector
+{
+public:
+	using value_type	= uint64_t;
+	using size_type		= size_t;
+	using iterator		= value_type*;
+	using const_iterator = const value_type*;
+
+	static constexpr size_type kINLINE_LIMBS = 2;
+
+	LimbVector() noexcept = default;
+	~LimbVector() { release(); }
+
+	explicit LimbVector(const size_type count, const value_type val = 0) { resize(count, val); }
+	LimbVector(std::initializer_list<value_type> list) { assign(list.begin(), list.end()); }
+	LimbVector(const value_type* first, const value_type* last) { assign(first, last); }
+
+	LimbVector(const LimbVector& other) { assign(other.begin(), other.end()); }
+	LimbVector(LimbVector&& other) noexcept { moveFrom(std::move(other)); }
+
+	LimbVector& operator=(const LimbVector& other) { if (this != &other) { assign(other.begin(), other.end()); } return *this; }
+	LimbVector& operator=(LimbVector&& other) noexcept { if (this != &other) { release(); moveFrom(std::move(other)); } return *this; }
+
+	// count limbs at first, left where they are. Only reads are allowed until something grows the vector,
+	// which copies them, so it suits a const value. The limbs have to outlive the vector.
+	static inline LimbVector borrow(const value_type* first, const size_type count);
+
+	inline size_type size() const { return m_size; }
+	inline size_type capacity() const { return m_capacity; }
+	inline bool empty() const { return m_size == 0; }
+	inline bool isInline() const { return m_capacity == kINLINE_LIMBS; }
+	inline bool isBorrowed() const { return m_capacity == 0; }
+
+	inline value_type* data() { return isInline() ? m_inline : m_heap; }
+	inline const value_type* data() const { return isInline() ? m_inline : m_heap; }
+
+	inline iterator begin() { return data(); }
+	inline iterator end() { return data() + m_size; }
+	inline const_iterator begin() const { return data(); }
+	inline const_iterator end() const { return data() + m_size; }
+
+	inline value_type& operator[](const size_type pos) { return data()[pos]; }
+	inline const value_type& operator[](const size_type pos) const { return data()[pos]; }
+	inline value_type& back() { return data()[m_size - 1]; }
+	inline const value_type& back() const { return data()[m_size - 1]; }
+
+	inline void reserve(const size_type count);
+	inline void resize(const size_type count, const value_type val = 0);
+	inline void push_back(const value_type val) { if (m_size >= m_capacity) { reserve(std::max<size_type>(2 * m_capacity, m_size + 1)); } data()[m_size++] = val; }
+	inline void pop_back() { m_size--; }
+	inline void clear() { m_size = 0; }
+
+	inline void assign(const value_type* first, const value_type* last);
+	inline iterator insert(const_iterator pos, const size_type count, const value_type val);
+	inline iterator erase(const_iterator first, const_iterator last);
+
+	inline void swap(LimbVector& other) noexcept { LimbVector temp(std::move(other)); other = std::move(*this); *this = std::move(temp); }
+
+private:
+	inline void release() { if (!isInline() && !isBorrowed()) { delete[] m_heap; } m_capacity = kINLINE_LIMBS; m_size = 0; }
+	inline void moveFrom(LimbVector&& other) noexcept;
+
+private:
+	// 32 bit counts keep the object as small as a std::vector, a capacity of 0 marks a borrowed vector
+	uint32_t				m_size{};
+	uint32_t				m_capacity{ kINLINE_LIMBS };
+	union
+	{
+		value_type			m_inline[kINLINE_LIMBS]{};
+		value_type*			m_heap;
+	};
+};
+
+LimbVector LimbVector::borrow(const value_type* first, const size_type count)
+{
+	LimbVector result;
+	result.m_heap = const_cast<value_type*>(first);
+	result.m_capacity = 0;
+	result.m_size = static_cast<uint32_t>(count);
+	return result;
+}
+
+void LimbVector::reserve(const size_type count)
+{
+	if (count <= m_capacity)
+	{
+		return;
+	}
+	// A borrowed vector can be longer than its capacity of 0
+	const size_type newCapacity = std::max<size_type>({ count, static_cast<size_type>(m_size), m_capacity + m_capacity / 2 });
+	value_type* buffer = new value_type[newCapacity];
+	std::copy(begin(), end(), buffer);
+	const size_type size = m_size;
+	release();
+	m_heap = buffer;
+	m_capacity = static_cast<uint32_t>(newCapacity);
+	m_size = static_cast<uint32_t>(size);
+}
+
+void LimbVector::resize(const size_type count, const value_type val)
+{
+	if (count > m_size || !isBorrowed())
+	{
+		reserve(count);
+	}
+	if (count > m_size)
+	{
+		std::fill(data() + m_size, data() + count, val);
+	}
+	m_size = static_cast<uint32_t>(count);
+}
+
+void LimbVector::assign(const value_type* first, const value_type* last)
+{
+	const size_type count = static_cast<size_type>(last - first);
+	if (count > m_capacity)
+	{
+		// first may point inside this vector, the old buffer has to outlive the copy
+		value_type* buffer = new value_type[count];
+		std::copy(first, last, buffer);
+		release();
+		m_heap = buffer;
+		m_capacity = static_cast<uint32_t>(count);
+	}
+	else
+	{
+		std::copy(first, last, data());
+	}
+	m_size = static_cast<uint32_t>(count);
+}
+
+LimbVector::iterator LimbVector::insert(const_iterator pos, const size_type count, const value_type val)
+{
+	const size_type index = static_cast<size_type>(pos - begin());
+	reserve(m_size + count);
+	value_type* first = data() + index;
+	std::copy_backward(first, data() + m_size, data() + m_size + count);
+	std::fill(first, first + count, val);
+	m_size += static_cast<uint32_t>(count);
+	return first;
+}
+
+LimbVector::iterator LimbVector::erase(const_iterator first, const_iterator last)
+{
+	value_type* dest = data() + (first - begin());
+	std::copy(last, const_iterator(end()), dest);
+	m_size -= static_cast<uint32_t>(last - first);
+	return dest;
+}
+
+void LimbVector::moveFrom(LimbVector&& other) noexcept
+{
+	m_size = other.m_size;
+	m_capacity = other.m_capacity;
+	if (other.isInline())
+	{
+		std::copy(other.m_inline, other.m_inline + kINLINE_LIMBS, m_inline);
+	}
+	else
+	{
+		m_heap = other.m_heap;
+		other.m_capacity = kINLINE_LIMBS;
+	}
+	other.m_size = 0;
+}
+}	// namespace nsLimb
+}	// namespace nsNumber
+#endif // #ifndef __LIMB_VECTOR_H__
@@ -0,0 +1,178 @@
+/*
+	@file	: modContext.h
+	@breif	: Repeated modular arithmetic against one modulus
+
+	@NOTE	: The modulus is prepared once (see ModularReducer), reduce, addmod, submod and
+			  mulmod then only multiply, add and subtract. Operands have to be integers, the
+			  results are always in [0, modulus).
+			  Residues and reductions work in limbs the context keeps between calls, so the
+			  only allocation left is the result, and a context serves one thread at a time.
+*/
+
+#ifndef __MOD_CONTEXT_H__
+#define __MOD_CONTEXT_H__
+
+#include "BigNumber.h"
+#include "limbModular.h"
+
+namespace nsNumber
+{
+class ModContext
+{
+	using LimbVector	= nsLimb::LimbVector;
+	using Limb			= nsLimb::Limb;
+	using SizeType		= nsLimb::SizeType;
+public:
+	// modulus has to be a positive integer
+	inline explicit ModContext(const BigNumber& modulus);
+
+	inline bool isValid() const { return m_valid; }
+	inline const BigNumber& modulus() const { return m_modulus; }
+
+	inline BigNumber reduce(const BigNumber& a) const;
+	inline BigNumber addmod(const BigNumber& a, const BigNumber& b) const;
+	inline BigNumber submod(const BigNumber& a, const BigNumber& b) const;
+	inline BigNumber mulmod(const BigNumber& a, const BigNumber& b) const;
+
+private:
+	inline bool isOperand(const BigNumber& a) const;
+	// r = a mod modulus in size() limbs, negative values wrap around to modulus - (|a| mod modulus)
+	inline void residue(const BigNumber& a, Limb* r) const;
+	inline BigNumber fromResidue(const Limb* residue) const;
+
+private:
+	BigNumber					m_modulus;
+	bool						m_valid;
+	nsLimb::ModularReducer		m_reducer;
+	mutable LimbVector			m_residues;		// Two residues of (size() + 1) limbs
+	mutable LimbVector			m_work;			// Scratch of the reducer, grows with the largest operand
+};
+
+ModContext::ModContext(const BigNumber& modulus)
+	: m_modulus(modulus)
+	, m_valid(modulus.isFinite() && modulus.isInteger() && !modulus.isNegative() && !modulus.isZero())
+	, m_reducer(m_valid ? modulus.scaledMagnitude(0) : LimbVector{ 1 })
+	, m_residues(2 * m_reducer.size() + 2)
+	, m_work(m_reducer.scratchSize())
+{
+	if (!m_valid)
+	{
+		LOG_ERROR("Modulus has to be a positive integer!");
+	}
+}
+
+BigNumber ModContext::reduce(const BigNumber& a) const
+{
+	if (!isOperand(a))
+	{
+		return sNAN;
+	}
+	residue(a, m_residues.data());
+	return fromResidue(m_residues.data());
+}
+
+BigNumber ModContext::addmod(const BigNumber& a, const BigNumber& b) const
+{
+	if (!isOperand(a) || !isOperand(b))
+	{
+		return sNAN;
+	}
+	// Both residues are below the modulus, so is the sum after at most one subtraction
+	const LimbVector& m = m_reducer.modulus();
+	const SizeType n = m.size();
+	Limb* sum = m_residues.data();
+	Limb* other = sum + n + 1;
+	residue(a, sum);
+	residue(b, other);
+	sum[n] = nsLimb::add(sum, sum, n, other, n);
+	if (nsLimb::compare(sum, n + 1, m.data(), n) >= 0)
+	{
+		nsLimb::sub(sum, sum, n + 1, m.data(), n);
+	}
+	return fromResidue(sum);
+}
+
+BigNumber ModContext::submod(const BigNumber& a, const BigNumber& b) const
+{
+	if (!isOperand(a) || !isOperand(b))
+	{
+		return sNAN;
+	}
+	// a - b, and the modulus added back when that went below zero, the carry out cancels the borrow
+	const LimbVector& m = m_reducer.modulus();
+	const SizeType n = m.size();
+	Limb* diff = m_residues.data();
+	Limb* other = diff + n + 1;
+	residue(a, diff);
+	residue(b, other);
+	if (nsLimb::sub(diff, diff, n, other, n))
+	{
+		nsLimb::add(diff, diff, n, m.data(), n);
+	}
+	return fromResidue(diff);
+}
+
+BigNumber ModContext::mulmod(const BigNumber& a, const BigNumber& b) const
+{
+	if (!isOperand(a) || !isOperand(b))
+	{
+		return sNAN;
+	}
+	// The same residue twice is squared
+	Limb* x = m_residues.data();
+	Limb* y = (&a == &b) ? x : x + m_reducer.size() + 1;
+	residue(a, x);
+	if (y != x)
+	{
+		residue(b, y);
+	}
+	m_reducer.multiply(x, x, y, m_work.data());
+	return fromResidue(x);
+}
+
+bool ModContext::isOperand(const BigNumber& a) const
+{
+	if (!m_valid || a.empty())
+	{
+		LOG_ERROR("INVALID Operation!");
+		return false;
+	}
+	if (!a.isFinite() || !a.isInteger())
+	{
+		LOG_ERROR("Operand has to be an integer!");
+		return false;
+	}
+	return true;
+}
+
+void ModContext::residue(const BigNumber& a, Limb* r) const
+{
+	// Integers are read in place, only a negative scale (trailing zeros kept as an exponent) needs its limbs spelled out
+	LimbVector scaled;
+	if (a.m_scale != 0)
+	{
+		scaled = a.scaledMagnitude(0);
+	}
+	const LimbVector& magnitude = (a.m_scale != 0) ? scaled : a.m_limbs;
+	if (m_work.size() < 2 * magnitude.size() + 2)
+	{
+		m_work.resize(2 * magnitude.size() + 2);
+	}
+	const LimbVector& m = m_reducer.modulus();
+	const SizeType n = m.size();
+	m_reducer.reduce(r, magnitude.data(), magnitude.size(), m_work.data());
+	if (a.isNegative() && nsLimb::normalizedSize(r, n) != 0)
+	{
+		nsLimb::sub(r, m.data(), n, r, n);
+	}
+}
+
+BigNumber ModContext::fromResidue(const Limb* residue) const
+{
+	BigNumber result;
+	result.m_precision = m_modulus.m_precision;
+	result.m_limbs = LimbVector(residue, residue + nsLimb::normalizedSize(residue, m_reducer.size()));
+	return result;
+}
+}	// namespace nsNumber
+#endif // #ifndef __MOD_CONTEXT_H__
@@ -0,0 +1,605 @@
+/*
+	@file	: radixConversion.h
+	@breif	: Conversion between decimal text and limbs, powers of ten on limbs
+
+	@NOTE	: Binary limbs convert by divide and conquer above a few dozen limbs. The text is split
+			  at 19 * 2^k digits and the halves are joined, or split apart, by the power 10^(19 * 2^k),
+			  taken from a tree of powers that is squared up once and kept. The low zero limbs of
+			  those powers (their 2^(19 * 2^k) part) are a shift and left out of the products.
+*/
+
+#ifndef __RADIX_CONVERSION_H__
+#define __RADIX_CONVERSION_H__
+
+#include <cmath>
+#include <deque>
+#include <mutex>
+#include <string>
+
+#include "limbArithmetic.h"
+#include "limbMultiply.h"
+#include "limbDivide.h"
+
+namespace nsNumber
+{
+namespace nsLimb
+{
+// Largest power of ten fitting in a limb
+constexpr unsigned kDECIMAL_BLOCK_DIGITS = 19;
+constexpr Limb kDECIMAL_BLOCK = 10000000000000000000ULL;
+// Sizes (in limbs) from where the divide and conquer conversions beat the block by block loops
+constexpr SizeType kTO_DECIMAL_THRESHOLD = 30;
+constexpr SizeType kFROM_DECIMAL_THRESHOLD = 120;
+
+inline Limb pow10Limb(const unsigned exp)
+{
+	static const Limb kPOW10[kDECIMAL_BLOCK_DIGITS + 1] = {
+		1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+		10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+		1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL,
+		10000000000000000000ULL };
+	return kPOW10[exp];
+}
+
+// val *= 10^exp on a native 128 bit value, false on overflow
+inline bool multiplyByPow10(DoubleLimb& val, SizeType exp)
+{
+	while (exp && val)
+	{
+		const unsigned digits = static_cast<unsigned>(std::min<SizeType>(exp, kDECIMAL_BLOCK_DIGITS));
+		if (__builtin_mul_overflow(val, static_cast<DoubleLimb>(pow10Limb(digits)), &val))
+		{
+			return false;
+		}
+		exp -= digits;
+	}
+	return true;
+}
+
+// a *= base^exp, base * base has to fit in a limb
+inline void multiplyByPower(LimbVector& a, const Limb base, SizeType exp)
+{
+	// Largest power of base fitting in a limb
+	Limb chunk = base;
+	SizeType chunkExp = 1;
+	while (chunk <= kLIMB_MAX / base)
+	{
+		chunk *= base;
+		chunkExp++;
+	}
+	normalize(a);
+	while (exp && !a.empty())
+	{
+		Limb factor = chunk;
+		SizeType count = chunkExp;
+		if (exp < chunkExp)
+		{
+			factor = 1;
+			for (count = 0; count < exp; ++count)
+			{
+				factor *= base;
+			}
+		}
+		const Limb carry = mulLimb(a.data(), a.data(), a.size(), factor);
+		if (carry)
+		{
+			a.push_back(carry);
+		}
+		exp -= count;
+	}
+}
+
+// 10^(19 * 2^level), every level is the square of the one below, built on first use and kept.
+// zeros is set to the count of low zero limbs, which the power of two in it leaves.
+inline const LimbVector& pow10Tree(const SizeType level, SizeType& zeros)
+{
+	static std::mutex mutex;
+	// A deque keeps the earlier levels in place while the tree grows
+	static std::deque<std::pair<LimbVector, SizeType>> tree{ { LimbVector{ kDECIMAL_BLOCK }, 0 } };
+
+	std::lock_guard<std::mutex> lock(mutex);
+	while (tree.size() <= level)
+	{
+		LimbVector next = square(tree.back().first);
+		SizeType count = 0;
+		while (next[count] == 0)
+		{
+			count++;
+		}
+		tree.emplace_back(std::move(next), count);
+	}
+	zeros = tree[level].second;
+	return tree[level].first;
+}
+
+// 10^exp
+inline LimbVector pow10(SizeType exp)
+{
+	if (kDECIMAL_LIMBS)
+	{
+		LimbVector result(exp / kDECIMAL_BLOCK_DIGITS, 0);
+		result.push_back(pow10Limb(static_cast<unsigned>(exp % kDECIMAL_BLOCK_DIGITS)));
+		return result;
+	}
+	// exp = 19 q + r, 10^exp is 10^r times the cached levels 10^(19 * 2^k) for the bits of q.
+	// Their low zero limbs are a shift, put in once at the end.
+	const SizeType q = exp / kDECIMAL_BLOCK_DIGITS;
+	LimbVector result{ pow10Limb(static_cast<unsigned>(exp % kDECIMAL_BLOCK_DIGITS)) };
+	SizeType shift = 0;
+	for (SizeType level = 0; (q >> level) != 0; ++level)
+	{
+		if (((q >> level) & 1) == 0)
+		{
+			continue;
+		}
+		SizeType zeros{};
+		const LimbVector& power = pow10Tree(level, zeros);
+		LimbVector product(result.size() + power.size() - zeros);
+		multiply(product.data(), result.data(), result.size(), power.data() + zeros, power.size() - zeros);
+		normalize(product);
+		result.swap(product);
+		shift += zeros;
+	}
+	result.insert(result.begin(), shift, 0);
+	return result;
+}
+
+// a *= 10^exp
+inline void multiplyByPow10(LimbVector& a, SizeType exp)
+{
+	normalize(a);
+	if (a.empty() || exp == 0)
+	{
+		return;
+	}
+	if (kDECIMAL_LIMBS)
+	{
+		// Whole limbs are a shift, the rest a single limb multiplication
+		a.insert(a.begin(), exp / kDECIMAL_BLOCK_DIGITS, 0);
+		exp %= kDECIMAL_BLOCK_DIGITS;
+	}
+	else if (exp > 4 * kDECIMAL_BLOCK_DIGITS)
+	{
+		a = multiply(a, pow10(exp));
+		return;
+	}
+	while (exp)
+	{
+		const unsigned digits = static_cast<unsigned>(std::min<SizeType>(exp, kDECIMAL_BLOCK_DIGITS - (kDECIMAL_LIMBS ? 1 : 0)));
+		const Limb carry = mulLimb(a.data(), a.data(), a.size(), pow10Limb(digits));
+		if (carry)
+		{
+			a.push_back(carry);
+		}
+		exp -= digits;
+	}
+}
+
+// quotient = a / 10^exp, remainder = a % 10^exp
+inline void divideByPow10(const LimbVector& a, SizeType exp, LimbVector& quotient, LimbVector& remainder)
+{
+	if (kDECIMAL_LIMBS && exp >= kDECIMAL_BLOCK_DIGITS)
+	{
+		// Whole limbs are split off, the rest is a single limb division
+		const SizeType n = normalizedSize(a.data(), a.size());
+		const SizeType whole = std::min<SizeType>(exp / kDECIMAL_BLOCK_DIGITS, n);
+		LimbVector low(a.begin(), a.begin() + whole);
+		LimbVector high(a.begin() + whole, a.begin() + n);
+		const unsigned digits = static_cast<unsigned>(exp % kDECIMAL_BLOCK_DIGITS);
+		if (digits && !high.empty())
+		{
+			const Limb r = divRemLimb(high.data(), high.data(), high.size(), pow10Limb(digits));
+			low.resize(whole + 1, 0);
+			low[whole] = r;
+		}
+		normalize(high);
+		normalize(low);
+		quotient.swap(high);
+		remainder.swap(low);
+		return;
+	}
+	if (exp <= kDECIMAL_BLOCK_DIGITS)
+	{
+		LimbVector q(a.size());
+		const Limb r = divRemLimb(q.data(), a.data(), a.size(), pow10Limb(static_cast<unsigned>(exp)));
+		normalize(q);
+		quotient.swap(q);
+		remainder.clear();
+		if (r)
+		{
+			remainder.push_back(r);
+		}
+		return;
+	}
+	divideAsIntegers(a, pow10(exp), quotient, remainder);
+}
+
+// quotient = value / 10^exp rounded to nearest, for a value only known to lie in
+// [a * base^shift, a * base^shift + base^error). Returns false when that range leaves the rounding open,
+// a tie or a remainder too close to one, and the exact value is needed.
+inline bool roundApproximateByPow10(const LimbVector& a, const SizeType shift, const SizeType error, const SizeType exp, LimbVector& quotient)
+{
+	LimbVector divisor;
+	LimbVector remainder;
+	LimbVector bound;
+	if (kDECIMAL_LIMBS)
+	{
+		// The whole limbs of base^shift cancel against 10^exp
+		if (shift * kDECIMAL_BLOCK_DIGITS >= exp)
+		{
+			return false;
+		}
+		divideByPow10(a, exp - shift * kDECIMAL_BLOCK_DIGITS, quotient, remainder);
+		divisor = pow10(exp - shift * kDECIMAL_BLOCK_DIGITS);
+		bound = pow10((error - shift) * kDECIMAL_BLOCK_DIGITS);
+	}
+	else
+	{
+		// The power of two in 10^exp cancels against base^shift, 5^exp is left to divide by
+		if (shift * kLIMB_BITS < exp)
+		{
+			return false;
+		}
+		const SizeType bits = shift * kLIMB_BITS - exp;
+		LimbVector numerator(a);
+		numerator.insert(numerator.begin(), bits / kLIMB_BITS, 0);
+		if (bits % kLIMB_BITS)
+		{
+			Limb* low = numerator.data() + bits / kLIMB_BITS;
+			numerator.push_back(shiftLeft(low, low, a.size(), static_cast<unsigned>(bits % kLIMB_BITS)));
+		}
+		divisor = power(LimbVector{ 5 }, LimbVector{ exp });
+		divideAsIntegers(numerator, divisor, quotient, remainder);
+		// Below one unit of the numerator when the error is below 2^exp
+		const SizeType boundBits = error * kLIMB_BITS > exp ? error * kLIMB_BITS - exp : 0;
+		bound.resize(boundBits / kLIMB_BITS + 1, 0);
+		bound.back() = static_cast<Limb>(1) << (boundBits % kLIMB_BITS);
+	}
+
+	// The exact remainder is in [remainder, remainder + bound)
+	LimbVector upper(std::max(remainder.size(), bound.size()) + 1, 0);
+	std::copy(remainder.begin(), remainder.end(), upper.begin());
+	add(upper.data(), upper.data(), upper.size(), bound.data(), bound.size());
+	normalize(upper);
+	LimbVector twice(std::max(remainder.size(), upper.size()) + 1);
+	twice[upper.size()] = add(twice.data(), upper.data(), upper.size(), upper.data(), upper.size());
+	if (compare(twice, divisor) <= 0)
+	{
+		return true;
+	}
+	std::fill(twice.begin(), twice.end(), 0);
+	twice[remainder.size()] = add(twice.data(), remainder.data(), remainder.size(), remainder.data(), remainder.size());
+	if (compare(twice, divisor) <= 0 || compare(upper, divisor) > 0)
+	{
+		return false;
+	}
+	quotient.push_back(0);
+	addLimb(quotient.data(), quotient.data(), quotient.size(), 1);
+	normalize(quotient);
+	return true;
+}
+
+// Strips trailing decimal zeros, not more than maxCount of them, returns the count removed
+inline SizeType removeTrailingDecimalZeros(LimbVector& a, const SizeType maxCount)
+{
+	normalize(a);
+	SizeType count = 0;
+	if (kDECIMAL_LIMBS)
+	{
+		// Zero limbs at the bottom are whole blocks of zero digits
+		SizeType whole = 0;
+		while (whole < a.size() && a[whole] == 0 && (whole + 1) * kDECIMAL_BLOCK_DIGITS <= maxCount)
+		{
+			whole++;
+		}
+		a.erase(a.begin(), a.begin() + whole);
+		count = whole * kDECIMAL_BLOCK_DIGITS;
+	}
+	while (!a.empty() && count < maxCount)
+	{
+		const unsigned digits = static_cast<unsigned>(std::min<SizeType>(maxCount - count, kDECIMAL_BLOCK_DIGITS - (kDECIMAL_LIMBS ? 1 : 0)));
+		Limb r = modLimb(a.data(), a.size(), pow10Limb(digits));
+		unsigned zeros = digits;
+		if (r != 0)
+		{
+			zeros = 0;
+			while (r % 10 == 0)
+			{
+				r /= 10;
+				zeros++;
+			}
+		}
+		if (zeros == 0)
+		{
+			break;
+		}
+		divRemLimb(a.data(), a.data(), a.size(), pow10Limb(zeros));
+		normalize(a);
+		count += zeros;
+		if (zeros < digits)
+		{
+			break;
+		}
+	}
+	return count;
+}
+
+// Block by block for binary limbs, every block of 19 digits is one multiply and add on the whole value
+inline LimbVector fromDecimalDigits(const char* digits, const SizeType count)
+{
+	LimbVector result;
+	SizeType pos = 0;
+	while (pos < count)
+	{
+		const SizeType blockSize = (pos == 0 && count % kDECIMAL_BLOCK_DIGITS) ? count % kDECIMAL_BLOCK_DIGITS : kDECIMAL_BLOCK_DIGITS;
+		Limb block = 0;
+		for (SizeType i = 0; i < blockSize; ++i)
+		{
+			block = block * 10 + static_cast<Limb>(digits[pos + i] - '0');
+		}
+		pos += blockSize;
+
+		Limb carry = mulLimb(result.data(), result.data(), result.size(), pow10Limb(static_cast<unsigned>(blockSize)));
+		if (carry)
+		{
+			result.push_back(carry);
+		}
+		carry = addLimb(result.data(), result.data(), result.size(), block);
+		if (carry)
+		{
+			result.push_back(carry);
+		}
+	}
+	normalize(result);
+	return result;
+}
+
+// high * 10^(19 * 2^level) + low for low < 10^(19 * 2^level)
+inline LimbVector joinByPow10Tree(const LimbVector& high, const LimbVector& low, const SizeType level)
+{
+	if (high.empty())
+	{
+		return low;
+	}
+	SizeType zeros{};
+	const LimbVector& power = pow10Tree(level, zeros);
+	// The zero limbs of the power are left out of the product and put back below it
+	LimbVector result(high.size() + power.size() + 1, 0);
+	multiply(result.data() + zeros, power.data() + zeros, power.size() - zeros, high.data(), high.size());
+	add(result.data(), result.data(), result.size(), low.data(), low.size());
+	normalize(result);
+	return result;
+}
+
+// Divide and conquer for binary limbs, high * 10^(19 * 2^k) + low with the low part at most half of the digits
+inline LimbVector fromDecimalRecursive(const char* digits, const SizeType count)
+{
+	if (count < kFROM_DECIMAL_THRESHOLD * kDECIMAL_BLOCK_DIGITS)
+	{
+		return fromDecimalDigits(digits, count);
+	}
+	SizeType level = 0;
+	while ((static_cast<SizeType>(kDECIMAL_BLOCK_DIGITS) << (level + 1)) <= count / 2)
+	{
+		level++;
+	}
+	const SizeType lowDigits = static_cast<SizeType>(kDECIMAL_BLOCK_DIGITS) << level;
+	return joinByPow10Tree(fromDecimalRecursive(digits, count - lowDigits), fromDecimalRecursive(digits + count - lowDigits, lowDigits), level);
+}
+
+// Blocks of 19 digits, least significant first, to limbs. Decimal limbs are the blocks already,
+// binary limbs split them as fromDecimalRecursive does.
+inline LimbVector fromDecimalBlocks(const Limb* blocks, SizeType n)
+{
+	n = normalizedSize(blocks, n);
+	if (kDECIMAL_LIMBS)
+	{
+		return LimbVector(blocks, blocks + n);
+	}
+	if (n < kFROM_DECIMAL_THRESHOLD)
+	{
+		LimbVector result;
+		for (SizeType i = n; i-- > 0;)
+		{
+			Limb carry = mulLimb(result.data(), result.data(), result.size(), kDECIMAL_BLOCK);
+			if (carry)
+			{
+				result.push_back(carry);
+			}
+			carry = addLimb(result.data(), result.data(), result.size(), blocks[i]);
+			if (carry)
+			{
+				result.push_back(carry);
+			}
+		}
+		return result;
+	}
+	SizeType level = 0;
+	while ((static_cast<SizeType>(1) << (level + 1)) <= n / 2)
+	{
+		level++;
+	}
+	const SizeType lowBlocks = static_cast<SizeType>(1) << level;
+	return joinByPow10Tree(fromDecimalBlocks(blocks + lowBlocks, n - lowBlocks), fromDecimalBlocks(blocks, lowBlocks), level);
+}
+
+// Digits are '0' to '9' only, leading zeros are allowed
+inline LimbVector fromDecimal(const char* digits, const SizeType count)
+{
+	if (kDECIMAL_LIMBS)
+	{
+		// Every limb is one block of digits, read from the least significant end
+		LimbVector result;
+		result.reserve(count / kDECIMAL_BLOCK_DIGITS + 1);
+		for (SizeType end = count; end > 0;)
+		{
+			const SizeType begin = end > kDECIMAL_BLOCK_DIGITS ? end - kDECIMAL_BLOCK_DIGITS : 0;
+			Limb block = 0;
+			for (SizeType i = begin; i < end; ++i)
+			{
+				block = block * 10 + static_cast<Limb>(digits[i] - '0');
+			}
+			result.push_back(block);
+			end = begin;
+		}
+		normalize(result);
+		return result;
+	}
+	return fromDecimalRecursive(digits, count);
+}
+
+// Writes a < 10^width into the width characters at out, right aligned behind leading zeros.
+// Block by block for binary limbs, every block of 19 digits is one division of the whole value.
+inline void toDecimalBlocks(const Limb* a, SizeType n, char* out, const SizeType width)
+{
+	n = normalizedSize(a, n);
+	char* pos = out + width;
+	// Values below the divide and conquer threshold are divided in a copy on the stack
+	Limb stack[kTO_DECIMAL_THRESHOLD];
+	LimbVector heap;
+	Limb* value = stack;
+	if (n > kTO_DECIMAL_THRESHOLD)
+	{
+		heap.assign(a, a + n);
+		value = heap.data();
+	}
+	else
+	{
+		std::copy(a, a + n, stack);
+	}
+	const LimbDivisor block(kDECIMAL_BLOCK);
+	while (n > 0)
+	{
+		Limb r = block.divRem(value, value, n);
+		n = normalizedSize(value, n);
+		for (unsigned i = 0; i < kDECIMAL_BLOCK_DIGITS && pos > out; ++i)
+		{
+			*--pos = static_cast<char>('0' + r % 10);
+			r /= 10;
+		}
+	}
+	std::fill(out, pos, '0');
+}
+
+// Divide and conquer for binary limbs, the remainder by 10^(19 * 2^k) gives the low digits and
+// the quotient the rest, with the low part at most half of the width
+inline void toDecimalRecursive(const Limb* a, SizeType n, char* out, const SizeType width)
+{
+	n = normalizedSize(a, n);
+	if (n < kTO_DECIMAL_THRESHOLD)
+	{
+		toDecimalBlocks(a, n, out, width);
+		return;
+	}
+	SizeType level = 0;
+	while ((static_cast<SizeType>(kDECIMAL_BLOCK_DIGITS) << (level + 1)) <= width / 2)
+	{
+		level++;
+	}
+	const SizeType lowDigits = static_cast<SizeType>(kDECIMAL_BLOCK_DIGITS) << level;
+	SizeType zeros{};
+	const LimbVector& power = pow10Tree(level, zeros);
+	if (n < power.size())
+	{
+		std::fill(out, out + width - lowDigits, '0');
+		toDecimalRecursive(a, n, out + width - lowDigits, lowDigits);
+		return;
+	}
+
+	// The zero limbs of the power are a shift, they stay as they are at the bottom of the remainder
+	LimbVector quotient(n - power.size() + 1);
+	LimbVector remainder(power.size());
+	divideAsIntegers(quotient.data(), remainder.data() + zeros, a + zeros, n - zeros, power.data() + zeros, power.size() - zeros);
+	std::copy(a, a + zeros, remainder.data());
+	toDecimalRecursive(quotient.data(), quotient.size(), out, width - lowDigits);
+	toDecimalRecursive(remainder.data(), remainder.size(), out + width - lowDigits, lowDigits);
+}
+
+// Characters toDecimalBackward may use for n limbs
+constexpr SizeType decimalDigitBound(const SizeType n) { return n * (kDECIMAL_BLOCK_DIGITS + 1) + 2; }
+
+// Writes the decimal digits of a without leading zeros so that they end right before end, returns their count,
+// 0 for zero. decimalDigitBound(n) characters before end may be written. Below kTO_DECIMAL_THRESHOLD limbs
+// nothing goes on the heap.
+inline SizeType toDecimalBackward(const Limb* a, SizeType n, char* end)
+{
+	n = normalizedSize(a, n);
+	if (n == 0)
+	{
+		return 0;
+	}
+	char* pos = end;
+	if (kDECIMAL_LIMBS)
+	{
+		for (SizeType i = 0; i < n; ++i)
+		{
+			Limb r = a[i];
+			for (unsigned j = 0; j < kDECIMAL_BLOCK_DIGITS && (r || i + 1 < n); ++j)
+			{
+				*--pos = static_cast<char>('0' + r % 10);
+				r /= 10;
+			}
+		}
+		return static_cast<SizeType>(end - pos);
+	}
+	// a < 2^bits <= 10^width, the few leading zeros this leaves are not counted
+	const SizeType bits = n * kLIMB_BITS - countLeadingZeros(a[n - 1]);
+	const SizeType width = static_cast<SizeType>(static_cast<double>(bits) * 0.30102999566398120) + 2;
+	toDecimalRecursive(a, n, end - width, width);
+	SizeType count = width;
+	while (*(end - count) == '0')
+	{
+		count--;
+	}
+	return count;
+}
+
+// Returns the decimal digits without leading zeros, "0" for zero
+inline std::string toDecimal(const Limb* a, SizeType n)
+{
+	std::string szRet(decimalDigitBound(n), '0');
+	const SizeType count = toDecimalBackward(a, n, &szRet[0] + szRet.size());
+	szRet.erase(0, szRet.size() - std::max<SizeType>(count, 1));
+	return szRet;
+}
+
+inline std::string toDecimal(const LimbVector& a) { return toDecimal(a.data(), a.size()); }
+
+// Number of decimal digits, 0 for zero
+inline SizeType decimalDigitCount(const LimbVector& a)
+{
+	const SizeType n = normalizedSize(a.data(), a.size());
+	if (n == 0)
+	{
+		return 0;
+	}
+	if (n == 1)
+	{
+		SizeType count = 1;
+		while (count <= kDECIMAL_BLOCK_DIGITS && a[0] >= pow10Limb(static_cast<unsigned>(count)))
+		{
+			count++;
+		}
+		return count;
+	}
+	if (kDECIMAL_LIMBS)
+	{
+		return (n - 1) * kDECIMAL_BLOCK_DIGITS + decimalDigitCount(LimbVector{ a[n - 1] });
+	}
+	// log10 of the top 128 bits and of the limbs under them, good to far better than 1e-6
+	const long double top = static_cast<long double>(a[n - 1]) * 18446744073709551616.0L + static_cast<long double>(a[n - 2]);
+	const long double log = std::log10(top) + static_cast<long double>(n - 2) * kLIMB_BITS * 0.301029995663981195213738894724493L;
+	const long double whole = std::floor(log);
+	if (log - whole > 1e-6L && whole + 1 - log > 1e-6L)
+	{
+		return static_cast<SizeType>(whole) + 1;
+	}
+	// Too close to a power of ten to tell, the estimate is the exact count or one less
+	const SizeType bits = n * kLIMB_BITS - countLeadingZeros(a[n - 1]);
+	const SizeType estimate = static_cast<SizeType>(static_cast<double>(bits - 1) * 0.30102999566398120) + 1;
+	const LimbVector bound = pow10(estimate);
+	return compare(a.data(), n, bound.data(), bound.size()) >= 0 ? estimate + 1 : estimate;
+}
+}	// namespace nsLimb
+}	// namespace nsNumber
+#endif // #ifndef __RADIX_CONVERSION_H__
@@ -0,0 +1,295 @@
+/*
+	@file	: serialization.h
+	@breif	: Versioned little-endian binary encoding of BigNumber
+
+	@NOTE	: A 32 byte header followed by the raw limbs, 8 bytes each and least significant first:
+				bytes  0 -  3 : magic "BNUM"
+				byte   4      : format version
+				byte   5      : flags, bit 0 negative, bit 1 limbs in radix 10^19 instead of 2^64
+				byte   6      : state, 0 finite, 1 NAN, 2 INFINITY, 3 empty
+				byte   7      : zero
+				bytes  8 - 15 : scale, signed, value = limbs / 10^scale
+				bytes 16 - 23 : precision
+				bytes 24 - 31 : limb count
+			  Every record is a multiple of 8 bytes, so records packed one after the other in an
+			  8 byte aligned buffer keep their limbs aligned and a view reads them in place.
+*/
+
+#ifndef __SERIALIZATION_H__
+#define __SERIALIZATION_H__
+
+#include <algorithm>
+#include <cstring>
+
+#include "BigNumber.h"
+
+namespace nsNumber
+{
+namespace nsSerial
+{
+constexpr unsigned char kMAGIC[4] = { 'B', 'N', 'U', 'M' };
+constexpr uint8_t kVERSION = 1;
+constexpr size_t kHEADER_SIZE = 32;
+constexpr size_t kLIMB_SIZE = 8;
+
+constexpr uint8_t kFLAG_NEGATIVE = 1;
+constexpr uint8_t kFLAG_DECIMAL_LIMBS = 2;
+
+constexpr uint8_t kSTATE_FINITE = 0;
+constexpr uint8_t kSTATE_NAN = 1;
+constexpr uint8_t kSTATE_INFINITY = 2;
+constexpr uint8_t kSTATE_EMPTY = 3;
+
+// Limbs can be copied, or read in place, as they are only when the host is little-endian too
+constexpr bool kLITTLE_ENDIAN_HOST = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+
+inline void storeLE(unsigned char* out, uint64_t val)
+{
+	for (size_t i = 0; i < 8; ++i)
+	{
+		out[i] = static_cast<unsigned char>(val >> (8 * i));
+	}
+}
+
+inline uint64_t loadLE(const unsigned char* in)
+{
+	uint64_t val = 0;
+	for (size_t i = 0; i < 8; ++i)
+	{
+		val |= static_cast<uint64_t>(in[i]) << (8 * i);
+	}
+	return val;
+}
+}	// namespace nsSerial
+
+// Bytes serialize writes for value
+inline size_t serializedSize(const BigNumber& value)
+{
+	return nsSerial::kHEADER_SIZE + value.m_limbs.size() * nsSerial::kLIMB_SIZE;
+}
+
+// Writes value into buffer, returns the bytes written or 0 when capacity is too small
+inline size_t serialize(const BigNumber& value, void* buffer, const size_t capacity)
+{
+	const size_t bytes = serializedSize(value);
+	if (capacity < bytes)
+	{
+		LOG_ERROR("Buffer too small!");
+		return 0;
+	}
+
+	unsigned char* out = static_cast<unsigned char*>(buffer);
+	std::memcpy(out, nsSerial::kMAGIC, sizeof(nsSerial::kMAGIC));
+	out[4] = nsSerial::kVERSION;
+	out[5] = static_cast<uint8_t>((value.m_bNegative ? nsSerial::kFLAG_NEGATIVE : 0) | (nsLimb::kDECIMAL_LIMBS ? nsSerial::kFLAG_DECIMAL_LIMBS : 0));
+	switch (value.m_state)
+	{
+	case BigNumber::State::kFINITE:		out[6] = nsSerial::kSTATE_FINITE; break;
+	case BigNumber::State::kNAN:		out[6] = nsSerial::kSTATE_NAN; break;
+	case BigNumber::State::kINFINITY:	out[6] = nsSerial::kSTATE_INFINITY; break;
+	case BigNumber::State::kEMPTY:		out[6] = nsSerial::kSTATE_EMPTY; break;
+	}
+	out[7] = 0;
+	nsSerial::storeLE(out + 8, static_cast<uint64_t>(value.m_scale));
+	// A precision lowered after the value was computed is widened to its scale so the record still reads back
+	const bool fraction = !value.m_limbs.empty() && value.m_scale > 0;
+	nsSerial::storeLE(out + 16, fraction ? std::max<uint64_t>(value.m_precision, static_cast<uint64_t>(value.m_scale)) : value.m_precision);
+	nsSerial::storeLE(out + 24, value.m_limbs.size());
+
+	unsigned char* limbs = out + nsSerial::kHEADER_SIZE;
+	if (nsSerial::kLITTLE_ENDIAN_HOST)
+	{
+		std::memcpy(limbs, value.m_limbs.data(), value.m_limbs.size() * nsSerial::kLIMB_SIZE);
+	}
+	else
+	{
+		for (size_t i = 0; i < value.m_limbs.size(); ++i)
+		{
+			nsSerial::storeLE(limbs + i * nsSerial::kLIMB_SIZE, value.m_limbs[i]);
+		}
+	}
+	return bytes;
+}
+
+// A serialized value read where it lies. value() borrows the limbs in place wherever limbs() can,
+// so arithmetic on it reads the buffer itself, toBigNumber makes an owning copy.
+// The buffer has to outlive the view. Malformed data leaves the view invalid and its value NAN.
+class BigNumberView
+{
+	using SizeType		= size_t;
+	using ScaleType		= int64_t;
+	using Limb			= nsLimb::Limb;
+public:
+	BigNumberView() = default;
+	inline BigNumberView(const void* buffer, const SizeType size);
+
+	// A copy borrows the same limbs again
+	BigNumberView(const BigNumberView& other) : m_data(other.m_data), m_limbCount(other.m_limbCount) { bind(); }
+	BigNumberView& operator=(const BigNumberView& other) { m_data = other.m_data; m_limbCount = other.m_limbCount; bind(); return *this; }
+
+	inline bool isValid() const { return m_data != nullptr; }
+	inline bool isFinite() const { return isValid() && m_data[6] == nsSerial::kSTATE_FINITE; }
+	inline bool isNegative() const { return isValid() && (m_data[5] & nsSerial::kFLAG_NEGATIVE) != 0; }
+
+	inline ScaleType scale() const { return isValid() ? static_cast<ScaleType>(nsSerial::loadLE(m_data + 8)) : 0; }
+	inline SizeType precision() const { return isValid() ? nsSerial::loadLE(m_data + 16) : 0; }
+	inline SizeType limbCount() const { return m_limbCount; }
+
+	// Bytes of the record, where the next one starts in a packed buffer
+	inline SizeType byteSize() const { return isValid() ? nsSerial::kHEADER_SIZE + m_limbCount * nsSerial::kLIMB_SIZE : 0; }
+
+	// Limb i, least significant first
+	inline Limb limb(const SizeType i) const { return nsSerial::loadLE(m_data + nsSerial::kHEADER_SIZE + i * nsSerial::kLIMB_SIZE); }
+
+	// The limbs in place, null when the host byte order or the buffer alignment does not allow that
+	inline const Limb* limbs() const;
+
+	inline const BigNumber& value() const { return m_value; }
+	inline BigNumber toBigNumber() const { return m_value; }
+
+private:
+	inline void bind();
+
+private:
+	const unsigned char*	m_data{};
+	SizeType				m_limbCount{};
+	BigNumber				m_value{ sNAN };
+};
+
+BigNumberView::BigNumberView(const void* buffer, const SizeType size)
+{
+	const unsigned char* data = static_cast<const unsigned char*>(buffer);
+	if (data == nullptr || size < nsSerial::kHEADER_SIZE || std::memcmp(data, nsSerial::kMAGIC, sizeof(nsSerial::kMAGIC)) != 0)
+	{
+		LOG_ERROR("Not a serialized BigNumber!");
+		return;
+	}
+	if (data[4] != nsSerial::kVERSION)
+	{
+		LOG_ERROR("Unsupported format version!");
+		return;
+	}
+	if (((data[5] & nsSerial::kFLAG_DECIMAL_LIMBS) != 0) != nsLimb::kDECIMAL_LIMBS)
+	{
+		LOG_ERROR("Limb radix does not match this build!");
+		return;
+	}
+
+	const SizeType count = nsSerial::loadLE(data + 24);
+	const bool finite = data[6] == nsSerial::kSTATE_FINITE;
+	// Scale and precision within what the text parser accepts, the scale negated as unsigned so INT64_MIN cannot overflow
+	const uint64_t scale = nsSerial::loadLE(data + 8);
+	const uint64_t scaleMagnitude = (scale >> 63) ? 0 - scale : scale;
+	const uint64_t maxDigits = static_cast<uint64_t>(BigNumber::kMAX_RESULT_DIGITS);
+	if (data[6] > nsSerial::kSTATE_EMPTY || data[7] != 0 || (data[5] & ~(nsSerial::kFLAG_NEGATIVE | nsSerial::kFLAG_DECIMAL_LIMBS)) != 0
+		|| count > (size - nsSerial::kHEADER_SIZE) / nsSerial::kLIMB_SIZE || count > UINT32_MAX || (!finite && count != 0)
+		|| scaleMagnitude > maxDigits || nsSerial::loadLE(data + 16) > maxDigits)
+	{
+		LOG_ERROR("Corrupt header!");
+		return;
+	}
+
+	// Limbs as the arithmetic keeps them, no zero on top and every decimal limb below 10^19
+	const unsigned char* limbs = data + nsSerial::kHEADER_SIZE;
+	if (count != 0 && nsSerial::loadLE(limbs + (count - 1) * nsSerial::kLIMB_SIZE) == 0)
+	{
+		LOG_ERROR("Corrupt limbs!");
+		return;
+	}
+	if (nsLimb::kDECIMAL_LIMBS)
+	{
+		for (SizeType i = 0; i < count; ++i)
+		{
+			if (nsSerial::loadLE(limbs + i * nsSerial::kLIMB_SIZE) >= nsLimb::kDECIMAL_BLOCK)
+			{
+				LOG_ERROR("Corrupt limbs!");
+				return;
+			}
+		}
+	}
+	// A fraction as trimZeros leaves it, no trailing zero and no more digits than the precision
+	const uint64_t precision = nsSerial::loadLE(data + 16);
+	if (count != 0 && !(scale >> 63) && scale != 0)
+	{
+		if (scale > precision)
+		{
+			LOG_ERROR("Corrupt header!");
+			return;
+		}
+		Limb lastDigit = nsSerial::loadLE(limbs) % 10;
+		if (!nsLimb::kDECIMAL_LIMBS)
+		{
+			// 2^64 is 6 mod 10, so the whole value has to be folded in from the top limb down
+			nsLimb::DoubleLimb rem = 0;
+			for (SizeType i = count; i-- > 0;)
+			{
+				rem = ((rem << 64) | nsSerial::loadLE(limbs + i * nsSerial::kLIMB_SIZE)) % 10;
+			}
+			lastDigit = static_cast<Limb>(rem);
+		}
+		if (lastDigit == 0)
+		{
+			LOG_ERROR("Corrupt limbs!");
+			return;
+		}
+	}
+	m_data = data;
+	m_limbCount = count;
+	bind();
+}
+
+const BigNumberView::Limb* BigNumberView::limbs() const
+{
+	if (!isValid() || !nsSerial::kLITTLE_ENDIAN_HOST)
+	{
+		return nullptr;
+	}
+	const unsigned char* limbs = m_data + nsSerial::kHEADER_SIZE;
+	return reinterpret_cast<uintptr_t>(limbs) % alignof(Limb) == 0 ? reinterpret_cast<const Limb*>(limbs) : nullptr;
+}
+
+void BigNumberView::bind()
+{
+	m_value = BigNumber();
+	if (!isValid())
+	{
+		m_value.m_state = BigNumber::State::kNAN;
+		return;
+	}
+	switch (m_data[6])
+	{
+	case nsSerial::kSTATE_NAN:		m_value.m_state = BigNumber::State::kNAN; break;
+	case nsSerial::kSTATE_INFINITY:	m_value.m_state = BigNumber::State::kINFINITY; break;
+	case nsSerial::kSTATE_EMPTY:	m_value.m_state = BigNumber::State::kEMPTY; break;
+	default:						m_value.m_state = BigNumber::State::kFINITE; break;
+	}
+	m_value.m_precision = precision();
+	if (m_limbCount == 0)
+	{
+		// Zero has no sign and no scale
+		m_value.m_bNegative = isNegative() && m_value.m_state == BigNumber::State::kINFINITY;
+		return;
+	}
+	m_value.m_bNegative = isNegative();
+	m_value.m_scale = scale();
+	if (const Limb* inPlace = limbs())
+	{
+		m_value.m_limbs = nsLimb::LimbVector::borrow(inPlace, m_limbCount);
+		return;
+	}
+	m_value.m_limbs.resize(m_limbCount);
+	for (SizeType i = 0; i < m_limbCount; ++i)
+	{
+		m_value.m_limbs[i] = limb(i);
+	}
+}
+
+// Reads a value written by serialize, returns the bytes read or 0 on malformed data, which leaves value NAN
+inline size_t deserialize(const void* buffer, const size_t size, BigNumber& value)
+{
+	const BigNumberView view(buffer, size);
+	value = view.toBigNumber();
+	return view.byteSize();
+}
+}	// namespace nsNumber
+#endif // #ifndef __SERIALIZATION_H__
@@ -1,16 +1,26 @@
 #ifndef __VERIFICATION_TEST_H__
 #define __VERIFICATION_TEST_H__
 
+#include <sstream>
 #include <string>
 #include <unordered_map>
 
 #include "BigNumber.h"
+#include "modContext.h"
+#include "serialization.h"
+#include "archive.h"
+#include "digitParser.h"
 
 namespace nsTest
 {
 using std::cout;
 using std::endl;
 using nsNumber::BigNumber;
+using nsNumber::ModContext;
+using nsNumber::BigNumberView;
+using nsNumber::ArchiveWriter;
+using nsNumber::MappedArchive;
+using nsNumber::DigitParser;
 
 class Tester
 {
@@ -22,10 +32,24 @@ public:
 	void additionTest();
 	void subtractionTest();
 	void multiplicationTest();
+	void squareTest();
 	
 	void divisionTest();
+	void divmodTest();
+	void modContextTest();
 
 	void powerTest();
+	void powmodTest();
+	void rootTest();
+	void perfectPowerTest();
+	void expLogTest();
+	void shortProductTest();
+	void scaleTest();
+	void radixTest();
+	void serializationTest();
+	void archiveTest();
+	void digitParserTest();
+	void charConvTest();
 
 	void preIncrementPositiveTest();
 	void preIncrementNegativeTest();
@@ -39,6 +63,8 @@ public:
 	void postDecrementPositiveTest();
 	void postDecrementNegativeTest();
 
+	void nativeOperandTest();
+
 private:
 	void printStats();
 private:
@@ -60,8 +86,22 @@ void Tester::runAll()
 	additionTest();
 	subtractionTest();
 	multiplicationTest();
+	squareTest();
 	divisionTest();
+	divmodTest();
+	modContextTest();
 	powerTest();
+	powmodTest();
+	rootTest();
+	perfectPowerTest();
+	expLogTest();
+	shortProductTest();
+	scaleTest();
+	radixTest();
+	serializationTest();
+	archiveTest();
+	digitParserTest();
+	charConvTest();
 	preIncrementPositiveTest();
 	preIncrementNegativeTest();
 	preDecrementPositiveTest();
@@ -70,6 +110,7 @@ void Tester::runAll()
 	postIncrementNegativeTest();
 	postDecrementPositiveTest();
 	postDecrementNegativeTest();
+	nativeOperandTest();
 }
 
 void Tester::additionTest()
@@ -99,6 +140,11 @@ void Tester::additionTest()
 	num1.emplace_back("121932631112635269000000000000000000");
 	num2.emplace_back("243865262225270538000000000");
 	res.emplace_back("121932631356500531225270538000000000");
+
+	// Carry out of 128 bits
+	num1.emplace_back("340282366920938463463374607431768211455");
+	num2.emplace_back("1");
+	res.emplace_back("340282366920938463463374607431768211456");
 	
 	int pass = 0;
 	std::string str;
@@ -209,6 +255,19 @@ void Tester::multiplicationTest()
 	num1.emplace_back("123456789123456789");
 	num2.emplace_back("987654321987654321");
 	res.emplace_back("121932631356500531347203169112635269");
+
+	// Product overflowing 128 bits
+	num1.emplace_back("18446744073709551616");
+	num2.emplace_back("18446744073709551616");
+	res.emplace_back("340282366920938463463374607431768211456");
+
+	// (10^n - 1)^2 = 99..9800..01, large enough for the toom-3, toom-4 and ntt tiers
+	for (size_t n : { 7000, 50000, 300000 })
+	{
+		num1.emplace_back(n, '9');
+		num2.emplace_back(n, '9');
+		res.emplace_back(std::string(n - 1, '9') + "8" + std::string(n - 1, '0') + "1");
+	}
 	
 	num1.emplace_back("123456789123456789123456789");
 	num2.emplace_back("987654321987654321987654321");
@@ -261,6 +320,54 @@ void Tester::multiplicationTest()
 	m_stats["Multiply   "] = std::make_pair(static_cast<int>(num1.size()), pass);
 }
 
+void Tester::squareTest()
+{
+	cout << "Square Test\n";
+
+	std::vector<std::string> num1;
+	std::vector<std::string> res;
+
+	num1.emplace_back("-12345");
+	res.emplace_back("152399025");
+
+	num1.emplace_back("1.5");
+	res.emplace_back("2.25");
+
+	num1.emplace_back("0.0011");
+	res.emplace_back("0.000001");
+
+	num1.emplace_back("18446744073709551616");
+	res.emplace_back("340282366920938463463374607431768211456");
+
+	// (10^n - 1)^2 = 99..9800..01, through every squaring tier
+	for (size_t n : { 60, 1500, 7000, 50000, 300000 })
+	{
+		num1.emplace_back(n, '9');
+		res.emplace_back(std::string(n - 1, '9') + "8" + std::string(n - 1, '0') + "1");
+	}
+
+	int pass = 0;
+	std::string str;
+	for (size_t i = 0; i < num1.size(); ++i)
+	{
+		printf("Test                : %zu\n", i + 1);
+		printf("Number1  [%8zu] : %s\n", num1[i].size(), num1[i].c_str());
+		str = static_cast<std::string>(BigNumber(num1[i]).square());
+		printf("Expected [%8zu] : %s\n", res[i].size(), res[i].c_str());
+		printf("Got      [%8zu] : %s\n\n", str.size(), str.c_str());
+		if (str == res[i])
+		{
+			pass++;
+			printf("Square Test %2zu      : PASS\n\n\n", i + 1);
+		}
+		else
+		{
+			printf("Square Test %2zu      : FAIL\n\n\n", i + 1);
+		}
+	}
+	m_stats["Square     "] = std::make_pair(static_cast<int>(num1.size()), pass);
+}
+
 void Tester::divisionTest()
 {
 	cout << "Division Test\n";
@@ -313,6 +420,19 @@ void Tester::divisionTest()
 	num2.emplace_back("987654321987654321987654321123456789123456789123456789");
 	res.emplace_back("123456789123456789123456789987654321987654321987654321");
 
+	// Leading limbs of the running remainder equal to the divisor's
+	num1.emplace_back("6277101735386680765537201257812358733400781737549166030900");
+	num2.emplace_back("340282366920938463463374607431768211455");
+	res.emplace_back("18446744073709551621");
+
+	// 10^(2n) / (10^n - 1) = 10^n + 1 remainder 1, large enough for the recursive division
+	for (size_t n : { 7000, 50000 })
+	{
+		num1.emplace_back("1" + std::string(2 * n, '0'));
+		num2.emplace_back(n, '9');
+		res.emplace_back("1" + std::string(n - 1, '0') + "1");
+	}
+
 	int pass = 0;
 	std::string str;
 	for (size_t i = 0; i < num1.size(); ++i)
@@ -336,6 +456,189 @@ void Tester::divisionTest()
 	m_stats["Division   "] = std::make_pair(static_cast<int>(num1.size()), pass);
 }
 
+void Tester::divmodTest()
+{
+	cout << "Divmod Test\n";
+
+	std::vector<std::string> num1;
+	std::vector<std::string> num2;
+	std::vector<std::string> res;	// quotient and remainder for truncate, floor and euclidean
+
+	num1.emplace_back("7");
+	num2.emplace_back("2");
+	res.emplace_back("3 1, 3 1, 3 1");
+
+	num1.emplace_back("-7");
+	num2.emplace_back("2");
+	res.emplace_back("-3 -1, -4 1, -4 1");
+
+	num1.emplace_back("7");
+	num2.emplace_back("-2");
+	res.emplace_back("-3 1, -4 -1, -3 1");
+
+	num1.emplace_back("-7");
+	num2.emplace_back("-2");
+	res.emplace_back("3 -1, 3 -1, 4 1");
+
+	num1.emplace_back("-8");
+	num2.emplace_back("2");
+	res.emplace_back("-4 0, -4 0, -4 0");
+
+	num1.emplace_back("-7.5");
+	num2.emplace_back("2");
+	res.emplace_back("-3 -1.5, -4 0.5, -4 0.5");
+
+	num1.emplace_back("121932631356500531591068431581771069347203169112635270");
+	num2.emplace_back("-123456789123456789123456789");
+	res.emplace_back("-987654321987654321987654321 1, -987654321987654321987654322 -123456789123456789123456788, -987654321987654321987654321 1");
+
+	int pass = 0;
+	std::string str;
+	for (size_t i = 0; i < num1.size(); ++i)
+	{
+		printf("Test                : %zu\n", i + 1);
+		printf("Number1  [%8zu] : %s\n", num1[i].size(), num1[i].c_str());
+		printf("Number2  [%8zu] : %s\n", num2[i].size(), num2[i].c_str());
+		str.clear();
+		for (const BigNumber::DivisionMode mode : { BigNumber::DivisionMode::kTRUNCATE, BigNumber::DivisionMode::kFLOOR, BigNumber::DivisionMode::kEUCLIDEAN })
+		{
+			const std::pair<BigNumber, BigNumber> qr = divmod(BigNumber(num1[i]), BigNumber(num2[i]), mode);
+			str += (str.empty() ? "" : ", ") + static_cast<std::string>(qr.first) + " " + static_cast<std::string>(qr.second);
+		}
+		printf("Expected [%8zu] : %s\n", res[i].size(), res[i].c_str());
+		printf("Got      [%8zu] : %s\n\n", str.size(), str.c_str());
+		if (str == res[i])
+		{
+			pass++;
+			printf("Divmod Test %2zu      : PASS\n\n\n", i + 1);
+		}
+		else
+		{
+			printf("Divmod Test %2zu      : FAIL\n\n\n", i + 1);
+		}
+	}
+	m_stats["Divmod     "] = std::make_pair(static_cast<int>(num1.size()), pass);
+}
+
+void Tester::modContextTest()
+{
+	cout << "ModContext Test\n";
+
+	std::vector<std::string> mod;
+	std::vector<std::string> num1;
+	std::vector<std::string> num2;
+	std::vector<std::string> res;	// reduce(num1), addmod, submod and mulmod
+
+	mod.emplace_back("97");
+	num1.emplace_back("-5");
+	num2.emplace_back("200");
+	res.emplace_back("92 1 86 67");
+
+	mod.emplace_back("1000000007");
+	num1.emplace_back("123456789123456789");
+	num2.emplace_back("987654321987654321");
+	res.emplace_back("259259273 333333389 185185157 327846861");
+
+	mod.emplace_back("340282366920938463463374607431768211297");
+	num1.emplace_back("-1");
+	num2.emplace_back("340282366920938463463374607431768211296");
+	res.emplace_back("340282366920938463463374607431768211296 340282366920938463463374607431768211295 0 1");
+
+	mod.emplace_back("18446744073709551616");
+	num1.emplace_back("12345678901234567890123456789");
+	num2.emplace_back("-98765432109876543210");
+	res.emplace_back("5097733592125636885 17012765924506403371 11629445333454422015 14516778319884168398");
+
+	int pass = 0;
+	std::string str;
+	for (size_t i = 0; i < num1.size(); ++i)
+	{
+		printf("Test                : %zu\n", i + 1);
+		printf("Modulus  [%8zu] : %s\n", mod[i].size(), mod[i].c_str());
+		printf("Number1  [%8zu] : %s\n", num1[i].size(), num1[i].c_str());
+		printf("Number2  [%8zu] : %s\n", num2[i].size(), num2[i].c_str());
+		const ModContext ctx{ BigNumber(mod[i]) };
+		const BigNumber a(num1[i]);
+		const BigNumber b(num2[i]);
+		str = static_cast<std::string>(ctx.reduce(a)) + " " + static_cast<std::string>(ctx.addmod(a, b)) + " "
+			+ static_cast<std::string>(ctx.submod(a, b)) + " " + static_cast<std::string>(ctx.mulmod(a, b));
+		printf("Expected [%8zu] : %s\n", res[i].size(), res[i].c_str());
+		printf("Got      [%8zu] : %s\n\n", str.size(), str.c_str());
+		if (str == res[i])
+		{
+			pass++;
+			printf("ModContext Test %2zu  : PASS\n\n\n", i + 1);
+		}
+		else
+		{
+			printf("ModContext Test %2zu  : FAIL\n\n\n", i + 1);
+		}
+	}
+
+	// mulmod has to beat (a * b) % m on the same operands, a native two limb modulus and a three limb one.
+	// The best of a few alternating rounds is kept so that a busy machine does not decide it.
+	std::vector<std::string> timedMod;
+	std::vector<std::string> timedNum1;
+	std::vector<std::string> timedNum2;
+	std::vector<std::string> timedRes;
+
+	timedMod.emplace_back("98765432109876543211");
+	timedNum1.emplace_back("12345678901234567890");
+	timedNum2.emplace_back("55555555555555555555");
+	timedRes.emplace_back("9452160620476466055");
+
+	timedMod.emplace_back("9876543210987654321098765432109876543211");
+	timedNum1.emplace_back("1234567890123456789012345678901234567890");
+	timedNum2.emplace_back("5555555555555555555555555555555555555555");
+	timedRes.emplace_back("662193782019344377490020375257900963307");
+
+	for (size_t i = 0; i < timedMod.size(); ++i)
+	{
+		const BigNumber m(timedMod[i]);
+		const ModContext ctx{ m };
+		const BigNumber a(timedNum1[i]);
+		const BigNumber b(timedNum2[i]);
+		nsNumber::Timer timer;
+		int64_t bestMulmod = INT64_MAX;
+		int64_t bestPlain = INT64_MAX;
+		BigNumber viaContext;
+		BigNumber viaModulo;
+		for (int round = 0; round < 3; ++round)
+		{
+			timer.start();
+			for (int k = 0; k < 20000; ++k)
+			{
+				viaContext = ctx.mulmod(a, b);
+			}
+			bestMulmod = std::min<int64_t>(bestMulmod, timer.getElapsedUS().count());
+			timer.start();
+			for (int k = 0; k < 20000; ++k)
+			{
+				viaModulo = (a * b) % m;
+			}
+			bestPlain = std::min<int64_t>(bestPlain, timer.getElapsedUS().count());
+		}
+		str = static_cast<std::string>(viaContext) + " " + static_cast<std::string>(viaModulo);
+		const std::string expected = timedRes[i] + " " + timedRes[i];
+		printf("Test                : %zu\n", num1.size() + i + 1);
+		printf("Modulus  [%8zu] : %s\n", timedMod[i].size(), timedMod[i].c_str());
+		printf("Expected [%8zu] : %s\n", expected.size(), expected.c_str());
+		printf("Got      [%8zu] : %s\n", str.size(), str.c_str());
+		printf("mulmod x 20000      : %lld us\n", static_cast<long long>(bestMulmod));
+		printf("(a*b)%%m x 20000     : %lld us\n\n", static_cast<long long>(bestPlain));
+		if (str == expected && bestMulmod < bestPlain)
+		{
+			pass++;
+			printf("ModContext Test %2zu  : PASS\n\n\n", num1.size() + i + 1);
+		}
+		else
+		{
+			printf("ModContext Test %2zu  : FAIL\n\n\n", num1.size() + i + 1);
+		}
+	}
+	m_stats["ModContext "] = std::make_pair(static_cast<int>(num1.size() + timedMod.size()), pass);
+}
+
 void Tester::powerTest()
 {
 	cout << "Power Test\n";
@@ -356,7 +659,7 @@ void Tester::powerTest()
 
 	num1.emplace_back("2.5");
 	num2.emplace_back("2.5");
-	res.emplace_back("9.88212");
+	res.emplace_back("9.882118");
 
 	num1.emplace_back("12345");
 	num2.emplace_back("6");
@@ -937,6 +1240,856 @@ void Tester::powerTest()
 	m_stats["Power      "] = std::make_pair(static_cast<int>(num1.size()), pass);
 }
 
+void Tester::powmodTest()
+{
+	cout << "Powmod Test\n";
+
+	std::vector<std::string> num1;
+	std::vector<std::string> num2;
+	std::vector<std::string> mod;
+	std::vector<std::string> res;
+
+	num1.emplace_back("-3");
+	num2.emplace_back("101");
+	mod.emplace_back("1000000007");
+	res.emplace_back("341874888");
+
+	num1.emplace_back("2");
+	num2.emplace_back("1000000000000000000");
+	mod.emplace_back("170141183460469231731687303715884105727");
+	res.emplace_back("256");
+
+	num1.emplace_back("3");
+	num2.emplace_back("18446744073709551617");
+	mod.emplace_back("115792089237316195423570985008687907853269984665640564039457584007913129639936");
+	res.emplace_back("32925042014141301448817435362803735931819360079236581228174941073290410590211");
+
+	num1.emplace_back("123456789123456789");
+	num2.emplace_back("65537");
+	mod.emplace_back("10000000000000000000000000000000000000007");
+	res.emplace_back("8632321920289016948486110114826536154478");
+
+	num1.emplace_back("0");
+	num2.emplace_back("0");
+	mod.emplace_back("7");
+	res.emplace_back("1");
+
+	num1.emplace_back("12");
+	num2.emplace_back("0");
+	mod.emplace_back("1");
+	res.emplace_back("0");
+
+	int pass = 0;
+	std::string str;
+	for (size_t i = 0; i < num1.size(); ++i)
+	{
+		printf("Test                : %zu\n", i + 1);
+		printf("Number1  [%8zu] : %s\n", num1[i].size(), num1[i].c_str());
+		printf("Number2  [%8zu] : %s\n", num2[i].size(), num2[i].c_str());
+		printf("Modulus  [%8zu] : %s\n", mod[i].size(), mod[i].c_str());
+		str = static_cast<std::string>(powmod(BigNumber(num1[i]), BigNumber(num2[i]), BigNumber(mod[i])));
+		printf("Expected [%8zu] : %s\n", res[i].size(), res[i].c_str());
+		printf("Got      [%8zu] : %s\n\n", str.size(), str.c_str());
+		if (str == res[i])
+		{
+			pass++;
+			printf("Powmod Test %2zu      : PASS\n\n\n", i + 1);
+		}
+		else
+		{
+			printf("Powmod Test %2zu      : FAIL\n\n\n", i + 1);
+		}
+	}
+	m_stats["Powmod     "] = std::make_pair(static_cast<int>(num1.size()), pass);
+}
+
+void Tester::rootTest()
+{
+	cout << "Root Test\n";
+
+	std::vector<std::string> num1;
+	std::vector<uint64_t> num2;
+	std::vector<std::string> res;
+
+	num1.emplace_back("2");
+	num2.emplace_back(2);
+	res.emplace_back("1.414214");
+
+	num1.emplace_back("-27");
+	num2.emplace_back(3);
+	res.emplace_back("-3");
+
+	num1.emplace_back("2.5");
+	num2.emplace_back(2);
+	res.emplace_back("1.581139");
+
+	num1.emplace_back("0.000225");
+	num2.emplace_back(2);
+	res.emplace_back("0.015");
+
+	num1.emplace_back("0.000001");
+	num2.emplace_back(3);
+	res.emplace_back("0.01");
+
+	num1.emplace_back("123456789012345678901234567890");
+	num2.emplace_back(5);
+	res.emplace_back("658116.827427");
+
+	num1.emplace_back("99999999999999999999999999999999999999999");
+	num2.emplace_back(2);
+	res.emplace_back("316227766016837933199.889354");
+
+	int pass = 0;
+	std::string str;
+	for (size_t i = 0; i < num1.size(); ++i)
+	{
+		printf("Test                : %zu\n", i + 1);
+		printf("Number1  [%8zu] : %s\n", num1[i].size(), num1[i].c_str());
+		printf("Degree              : %llu\n", static_cast<unsigned long long>(num2[i]));
+		str = static_cast<std::string>(root(BigNumber(num1[i]), num2[i]));
+		printf("Expected [%8zu] : %s\n", res[i].size(), res[i].c_str());
+		printf("Got      [%8zu] : %s\n\n", str.size(), str.c_str());
+		if (str == res[i])
+		{
+			pass++;
+			printf("Root Test %2zu        : PASS\n\n\n", i + 1);
+		}
+		else
+		{
+			printf("Root Test %2zu        : FAIL\n\n\n", i + 1);
+		}
+	}
+	m_stats["Root       "] = std::make_pair(static_cast<int>(num1.size()), pass);
+}
+
+void Tester::perfectPowerTest()
+{
+	cout << "Perfect Power Test\n";
+
+	std::vector<std::string> num1;
+	std::vector<std::string> res;	// isqrt, its remainder, is_perfect_square and is_perfect_power
+
+	num1.emplace_back("10000000000000000000000000000000000000000012345");
+	res.emplace_back("100000000000000000000000 12345 0 0");
+
+	num1.emplace_back("99");
+	res.emplace_back("9 18 0 0");
+
+	num1.emplace_back("152415787532388367501905199875019052100");
+	res.emplace_back("12345678901234567890 0 1 1");
+
+	num1.emplace_back("152415787532388367501905199875019052101");
+	res.emplace_back("12345678901234567890 1 0 0");
+
+	num1.emplace_back("-4");
+	res.emplace_back("NAN NAN 0 0");
+
+	num1.emplace_back("65542350158517637872691969508970705427701150314738255642438471845988797065603");
+	res.emplace_back("256012402352928280693475150855618159698 156525390554972751767027240996565614399 0 1");
+
+	num1.emplace_back("170141183460469231731687303715884105727");
+	res.emplace_back("13043817825332782212 9119501915260492783 0 0");
+
+	num1.emplace_back("-32");
+	res.emplace_back("NAN NAN 0 1");
+
+	num1.emplace_back("1");
+	res.emplace_back("1 0 1 1");
+
+	num1.emplace_back("2.25");
+	res.emplace_back("NAN NAN 0 0");
+
+	int pass = 0;
+	std::string str;
+	for (size_t i = 0; i < num1.size(); ++i)
+	{
+		printf("Test                : %zu\n", i + 1);
+		printf("Number1  [%8zu] : %s\n", num1[i].size(), num1[i].c_str());
+		const BigNumber n(num1[i]);
+		const std::pair<BigNumber, BigNumber> sr = isqrt_rem(n);
+		str = static_cast<std::string>(sr.first) + " " + static_cast<std::string>(sr.second) + " "
+			+ (is_perfect_square(n) ? "1" : "0") + " " + (is_perfect_power(n) ? "1" : "0");
+		printf("Expected [%8zu] : %s\n", res[i].size(), res[i].c_str());
+		printf("Got      [%8zu] : %s\n\n", str.size(), str.c_str());
+		if (str == res[i] && isqrt(n) == sr.first)
+		{
+			pass++;
+			printf("Perfect Power Test %2zu : PASS\n\n\n", i + 1);
+		}
+		else
+		{
+			printf("Perfect Power Test %2zu : FAIL\n\n\n", i + 1);
+		}
+	}
+	m_stats["PerfectPow "] = std::make_pair(static_cast<int>(num1.size()), pass);
+}
+
+void Tester::expLogTest()
+{
+	cout << "Exp Log Test\n";
+
+	std::vector<std::string> func;
+	std::vector<std::string> num1;
+	std::vector<std::string> num2;	// Exponent of pow
+	std::vector<size_t> prec;		// Precision of num1, or of the constant
+	std::vector<std::string> res;
+
+	func.emplace_back("exp");
+	num1.emplace_back("1");
+	num2.emplace_back("");
+	prec.emplace_back(30);
+	res.emplace_back("2.718281828459045235360287471353");
+
+	func.emplace_back("exp");
+	num1.emplace_back("-1");
+	num2.emplace_back("");
+	prec.emplace_back(6);
+	res.emplace_back("0.367879");
+
+	func.emplace_back("exp");
+	num1.emplace_back("-100");
+	num2.emplace_back("");
+	prec.emplace_back(6);
+	res.emplace_back("0");
+
+	func.emplace_back("log");
+	num1.emplace_back("2");
+	num2.emplace_back("");
+	prec.emplace_back(30);
+	res.emplace_back("0.693147180559945309417232121458");
+
+	func.emplace_back("log");
+	num1.emplace_back("0.001");
+	num2.emplace_back("");
+	prec.emplace_back(6);
+	res.emplace_back("-6.907755");
+
+	func.emplace_back("log10");
+	num1.emplace_back("1000");
+	num2.emplace_back("");
+	prec.emplace_back(6);
+	res.emplace_back("3");
+
+	func.emplace_back("log10");
+	num1.emplace_back("2");
+	num2.emplace_back("");
+	prec.emplace_back(20);
+	res.emplace_back("0.30102999566398119521");
+
+	func.emplace_back("log");
+	num1.emplace_back("-2");
+	num2.emplace_back("");
+	prec.emplace_back(6);
+	res.emplace_back("NAN");
+
+	func.emplace_back("pow");
+	num1.emplace_back("1.05");
+	num2.emplace_back("3.25");
+	prec.emplace_back(30);
+	res.emplace_back("1.171831645380916585794170869495");
+
+	func.emplace_back("pow");
+	num1.emplace_back("2");
+	num2.emplace_back("0.5");
+	prec.emplace_back(50);
+	res.emplace_back("1.41421356237309504880168872420969807856967187537695");
+
+	func.emplace_back("pow");
+	num1.emplace_back("-8");
+	num2.emplace_back("0.5");
+	prec.emplace_back(6);
+	res.emplace_back("NAN");
+
+	func.emplace_back("pi");
+	num1.emplace_back("");
+	num2.emplace_back("");
+	prec.emplace_back(50);
+	res.emplace_back("3.14159265358979323846264338327950288419716939937511");
+
+	func.emplace_back("pi");
+	num1.emplace_back("");
+	num2.emplace_back("");
+	prec.emplace_back(4);
+	res.emplace_back("3.1416");
+
+	func.emplace_back("e");
+	num1.emplace_back("");
+	num2.emplace_back("");
+	prec.emplace_back(30);
+	res.emplace_back("2.718281828459045235360287471353");
+
+	func.emplace_back("ln2");
+	num1.emplace_back("");
+	num2.emplace_back("");
+	prec.emplace_back(30);
+	res.emplace_back("0.693147180559945309417232121458");
+
+	func.emplace_back("sqrt2");
+	num1.emplace_back("");
+	num2.emplace_back("");
+	prec.emplace_back(30);
+	res.emplace_back("1.41421356237309504880168872421");
+
+	const auto evaluate = [](const std::string& f, const BigNumber& x, const BigNumber& y, const size_t precision)
+	{
+		if (f == "exp")
+		{
+			return exp(x);
+		}
+		if (f == "log")
+		{
+			return log(x);
+		}
+		if (f == "log10")
+		{
+			return log10(x);
+		}
+		if (f == "pow")
+		{
+			return pow(x, y);
+		}
+		if (f == "pi")
+		{
+			return BigNumber::pi(precision);
+		}
+		if (f == "e")
+		{
+			return BigNumber::e(precision);
+		}
+		if (f == "ln2")
+		{
+			return BigNumber::ln2(precision);
+		}
+		return BigNumber::sqrt2(precision);
+	};
+
+	int pass = 0;
+	std::string str;
+	for (size_t i = 0; i < func.size(); ++i)
+	{
+		printf("Test                : %zu\n", i + 1);
+		printf("Function            : %s, precision %zu\n", func[i].c_str(), prec[i]);
+		printf("Number1  [%8zu] : %s\n", num1[i].size(), num1[i].c_str());
+		printf("Number2  [%8zu] : %s\n", num2[i].size(), num2[i].c_str());
+		BigNumber x(num1[i].empty() ? "0" : num1[i]);
+		x.setMaxPrecision(prec[i]);
+		const BigNumber y(num2[i].empty() ? "0" : num2[i]);
+		str = static_cast<std::string>(evaluate(func[i], x, y, prec[i]));
+		printf("Expected [%8zu] : %s\n", res[i].size(), res[i].c_str());
+		printf("Got      [%8zu] : %s\n\n", str.size(), str.c_str());
+		if (str == res[i])
+		{
+			pass++;
+			printf("Exp Log Test %2zu     : PASS\n\n\n", i + 1);
+		}
+		else
+		{
+			printf("Exp Log Test %2zu     : FAIL\n\n\n", i + 1);
+		}
+	}
+	m_stats["ExpLog     "] = std::make_pair(static_cast<int>(func.size()), pass);
+}
+
+void Tester::shortProductTest()
+{
+	std::string testName = "Short Product Test\n";
+	cout << testName;
+	bool passed = true;
+
+	// Long fractions rounded far above their last digit
+	BigNumber x = BigNumber::pi(400);
+	x.setMaxPrecision(200);
+	passed = passed && static_cast<std::string>(x * BigNumber::e(400)) == "8.53973422267356706546355086954657449503488853576511496187960113017922861115733080757256386971047394391377494251167746764632118759069602399061836345379070414542021599488963342852746700046687766093072711";
+	x = BigNumber::sqrt2(400);
+	x.setMaxPrecision(300);
+	passed = passed && static_cast<std::string>(x * x) == "2";
+
+	// 2^250 u / 10^251 times 5^251 / 10^251 is an exact tie at 251 digits, one more in the last digit is just above
+	const auto fraction = [](const std::string& digits)
+	{
+		BigNumber value(digits);
+		value.setMaxPrecision(251);
+		value.makeFloatingPoint();
+		return value / BigNumber("1" + std::string(251, '0'));
+	};
+	x = fraction("14071955289257176527170084983694711023834893969782707435350748056517220615964444444444444444444444435800243338186464577754249383031979101231581005863638448443270638298151780352");
+	const std::string tie = "0." + std::string(151, '0') + "3" + std::string(98, '8');
+	passed = passed && static_cast<std::string>(x * fraction("27635739376302222801236325960961278627571201166196100432075851104539493770119766585508824011111322324993751340627678923510384316629862229419689612086585839278995990753173828125")) == tie + "6";
+	passed = passed && static_cast<std::string>(x * fraction("27635739376302222801236325960961278627571201166196100432075851104539493770119766585508824011111322324993751340627678923510384316629862229419689612086585839278995990753173828126")) == tie + "7";
+
+	m_stats["ShortProd  "].first++;
+	if (passed)
+	{
+		m_stats["ShortProd  "].second++;
+		printf("%40s      : PASS\n\n\n", testName.c_str());
+	}
+	else
+	{
+		printf("%40s      : FAIL\n\n\n", testName.c_str());
+	}
+}
+
+void Tester::scaleTest()
+{
+	std::string testName = "Scale Test\n";
+	cout << testName;
+	bool passed = true;
+
+	// Powers of ten only move the scale
+	const BigNumber big = pow(BigNumber("10"), BigNumber("100000"));
+	passed = passed && big.size() == 100001 && static_cast<std::string>(big) == "1" + std::string(100000, '0');
+	passed = passed && static_cast<std::string>(big % BigNumber("7")) == "4";
+	passed = passed && static_cast<std::string>(pow(BigNumber("0.1"), BigNumber("3"))) == "0.001";
+	passed = passed && static_cast<std::string>(pow(BigNumber("-200"), BigNumber("3"))) == "-8000000";
+
+	// Trailing zeros of an integer are held in the scale
+	BigNumber x("123");
+	x.multiplyBy10(30);
+	passed = passed && static_cast<std::string>(x) == "123" + std::string(30, '0') && x.isInteger() && x.isEven();
+	passed = passed && static_cast<std::string>(x + BigNumber("1")) == "123" + std::string(29, '0') + "1";
+	passed = passed && static_cast<std::string>(x / BigNumber("123" + std::string(27, '0'))) == "1000";
+	passed = passed && x > BigNumber("122" + std::string(30, '9')) && x == BigNumber("123" + std::string(30, '0'));
+	x.divideBy10(32);
+	passed = passed && static_cast<std::string>(x) == "1.23" && x.isFloatingPoint();
+	x.divideBy10(5);
+	passed = passed && static_cast<std::string>(x) == "0.000012";
+	x = BigNumber("5");
+	x.multiplyBy10(3);
+	int64_t native{};
+	passed = passed && x == 5000 && x.asInteger(native) && native == 5000 && static_cast<std::string>(x % BigNumber("7")) == "2";
+
+	m_stats["Scale      "].first++;
+	if (passed)
+	{
+		m_stats["Scale      "].second++;
+		printf("%40s      : PASS\n\n\n", testName.c_str());
+	}
+	else
+	{
+		printf("%40s      : FAIL\n\n\n", testName.c_str());
+	}
+}
+
+void Tester::radixTest()
+{
+	cout << "Radix Conversion Test\n";
+
+	std::vector<std::string> num1;
+	std::vector<char> op;
+	std::vector<std::string> num2;
+	std::vector<std::string> res;	// num1 op num2, as text and through operator<<
+
+	// Long enough for the divide and conquer conversions, with zero runs across the split points
+	std::string digits("1");
+	for (int i = 0; i < 6000; ++i)
+	{
+		digits += static_cast<char>('0' + (i * 7 + i / 13) % 10);
+	}
+	digits.replace(1000, 900, 900, '0');
+	digits.replace(4000, 600, 600, '9');
+
+	num1.emplace_back(digits);
+	op.emplace_back('+');
+	num2.emplace_back("0");
+	res.emplace_back(digits);
+
+	num1.emplace_back("-000" + digits);
+	op.emplace_back('+');
+	num2.emplace_back("0");
+	res.emplace_back("-" + digits);
+
+	num1.emplace_back(5000, '1');
+	op.emplace_back('*');
+	num2.emplace_back("9");
+	res.emplace_back(5000, '9');
+
+	num1.emplace_back("1" + std::string(9000, '0'));
+	op.emplace_back('-');
+	num2.emplace_back("1");
+	res.emplace_back(9000, '9');
+
+	num1.emplace_back(3000, '9');
+	op.emplace_back('+');
+	num2.emplace_back("1");
+	res.emplace_back("1" + std::string(3000, '0'));
+
+	int pass = 0;
+	std::string str;
+	for (size_t i = 0; i < num1.size(); ++i)
+	{
+		printf("Test                : %zu\n", i + 1);
+		printf("Number1  [%8zu] : %s\n", num1[i].size(), num1[i].c_str());
+		printf("Operator            : %c\n", op[i]);
+		printf("Number2  [%8zu] : %s\n", num2[i].size(), num2[i].c_str());
+		const BigNumber a(num1[i]);
+		const BigNumber b(num2[i]);
+		const BigNumber value = (op[i] == '*') ? a * b : (op[i] == '-') ? a - b : a + b;
+		str = static_cast<std::string>(value);
+		std::ostringstream out;
+		out << value;
+		printf("Expected [%8zu] : %s\n", res[i].size(), res[i].c_str());
+		printf("Got      [%8zu] : %s\n\n", str.size(), str.c_str());
+		if (str == res[i] && out.str() == res[i] + "\n")
+		{
+			pass++;
+			printf("Radix Test %2zu       : PASS\n\n\n", i + 1);
+		}
+		else
+		{
+			printf("Radix Test %2zu       : FAIL\n\n\n", i + 1);
+		}
+	}
+	m_stats["Radix      "] = std::make_pair(static_cast<int>(num1.size()), pass);
+}
+
+void Tester::serializationTest()
+{
+	std::string testName = "Serialization Test\n";
+	cout << testName;
+	bool passed = true;
+
+	BigNumber fraction("-123456789012345678901234567890.125");
+	fraction.setMaxPrecision(40);
+	BigNumber scaled("7");
+	scaled.multiplyBy10(50);
+	const std::vector<BigNumber> values{ BigNumber(std::string(300, '9')), fraction, scaled, BigNumber("0"), BigNumber("NAN"), BigNumber("INFINITY"), BigNumber("-INFINITY") };
+
+	// Records packed one after the other, read back both by copy and in place
+	std::vector<uint64_t> buffer(1000);
+	unsigned char* out = reinterpret_cast<unsigned char*>(buffer.data());
+	size_t used = 0;
+	for (const BigNumber& value : values)
+	{
+		const size_t bytes = serialize(value, out + used, buffer.size() * sizeof(uint64_t) - used);
+		passed = passed && bytes == serializedSize(value) && bytes % 8 == 0;
+		used += bytes;
+	}
+	size_t pos = 0;
+	for (const BigNumber& value : values)
+	{
+		BigNumber copy;
+		const size_t bytes = deserialize(out + pos, used - pos, copy);
+		const BigNumberView view(out + pos, used - pos);
+		passed = passed && bytes != 0 && view.isValid() && view.byteSize() == bytes;
+		passed = passed && static_cast<std::string>(copy) == static_cast<std::string>(value) && copy.getMaxPrecision() == value.getMaxPrecision();
+		passed = passed && static_cast<std::string>(view.toBigNumber()) == static_cast<std::string>(value);
+		passed = passed && (view.limbCount() == 0 || (view.limbs() != nullptr && view.limbs()[0] == view.limb(0)));
+		pos += bytes;
+	}
+	passed = passed && pos == used;
+
+	// Short buffers and damaged headers are refused
+	BigNumber copy;
+	passed = passed && serialize(fraction, out, serializedSize(fraction) - 1) == 0;
+	passed = passed && deserialize(out, 31, copy) == 0 && static_cast<std::string>(copy) == "NAN";
+	nsNumber::nsSerial::storeLE(out + 8, static_cast<uint64_t>(INT64_MIN));
+	passed = passed && deserialize(out, used, copy) == 0 && !BigNumberView(out, used).isValid();
+	nsNumber::nsSerial::storeLE(out + 8, 0);
+	nsNumber::nsSerial::storeLE(out + 16, UINT64_MAX / 2);
+	passed = passed && deserialize(out, used, copy) == 0 && !BigNumberView(out, used).isValid();
+	nsNumber::nsSerial::storeLE(out + 16, values[0].getMaxPrecision());
+	passed = passed && deserialize(out, used, copy) != 0;
+	out[4] = 99;
+	passed = passed && deserialize(out, used, copy) == 0 && !BigNumberView(out, used).isValid();
+
+	// Fractions trimZeros or the precision would never leave are refused, 7.0 and 0.007000001 at precision 2
+	used = serialize(BigNumber("7"), out, buffer.size() * sizeof(uint64_t));
+	nsNumber::nsSerial::storeLE(out + 32, 70);
+	nsNumber::nsSerial::storeLE(out + 8, 1);
+	passed = passed && deserialize(out, used, copy) == 0 && !BigNumberView(out, used).isValid();
+	nsNumber::nsSerial::storeLE(out + 32, 7000001);
+	nsNumber::nsSerial::storeLE(out + 8, 9);
+	nsNumber::nsSerial::storeLE(out + 16, 2);
+	passed = passed && deserialize(out, used, copy) == 0 && !BigNumberView(out, used).isValid();
+	used = serialize(BigNumber("100000000000000000000"), out, buffer.size() * sizeof(uint64_t));
+	nsNumber::nsSerial::storeLE(out + 8, 1);
+	passed = passed && deserialize(out, used, copy) == 0 && !BigNumberView(out, used).isValid();
+
+	// A precision lowered below the scale after the fact still writes a readable record
+	BigNumber lowered("1.2345678901");
+	lowered.setMaxPrecision(2);
+	used = serialize(lowered, out, buffer.size() * sizeof(uint64_t));
+	passed = passed && deserialize(out, used, copy) == used && static_cast<std::string>(copy) == static_cast<std::string>(lowered);
+
+	m_stats["Serialize  "].first++;
+	if (passed)
+	{
+		m_stats["Serialize  "].second++;
+		printf("%40s      : PASS\n\n\n", testName.c_str());
+	}
+	else
+	{
+		printf("%40s      : FAIL\n\n\n", testName.c_str());
+	}
+}
+
+void Tester::archiveTest()
+{
+	std::string testName = "Archive Test\n";
+	cout << testName;
+	bool passed = true;
+
+	const std::string path = "archiveTest.bnar";
+	std::vector<BigNumber> values;
+	{
+		ArchiveWriter writer(path);
+		BigNumber value("-1.5");
+		for (int i = 0; i < 200; ++i)
+		{
+			values.push_back(value);
+			passed = passed && writer.append(value);
+			value = value * BigNumber("-3.25") + BigNumber(i);
+		}
+		values.push_back(BigNumber("NAN"));
+		passed = passed && writer.append(values.back()) && writer.close();
+	}
+
+	{
+		const MappedArchive archive(path);
+		passed = passed && archive.isValid() && archive.size() == values.size();
+		for (size_t i = 0; passed && i < values.size(); ++i)
+		{
+			passed = static_cast<std::string>(archive[i].value()) == static_cast<std::string>(values[i]);
+		}
+
+		// Arithmetic straight on the mapped limbs
+		const BigNumberView lhs = archive.view(150);
+		const BigNumberView rhs = archive.view(199);
+		passed = passed && lhs.limbs() != nullptr && rhs.limbs() != nullptr;
+		passed = passed && lhs.value() * rhs.value() == values[150] * values[199] && lhs.value() + rhs.value() == values[150] + values[199];
+		passed = passed && archive.at(42) == values[42] && !archive.view(values.size()).isValid();
+	}
+	std::remove(path.c_str());
+
+	passed = passed && !MappedArchive(path).isValid();
+
+	m_stats["Archive    "].first++;
+	if (passed)
+	{
+		m_stats["Archive    "].second++;
+		printf("%40s      : PASS\n\n\n", testName.c_str());
+	}
+	else
+	{
+		printf("%40s      : FAIL\n\n\n", testName.c_str());
+	}
+}
+
+void Tester::digitParserTest()
+{
+	std::string testName = "Digit Parser Test\n";
+	cout << testName;
+	bool passed = true;
+
+	// The same text whole and fed a few characters at a time
+	std::string text = "-";
+	for (int i = 0; i < 300; ++i)
+	{
+		text.push_back(static_cast<char>('0' + (i * 7 + 3) % 10));
+	}
+	text += ".0000000049999";
+	const BigNumber whole(text);
+	DigitParser parser;
+	for (size_t i = 0; i < text.size(); i += 7)
+	{
+		parser.feed(text.data() + i, std::min<size_t>(7, text.size() - i));
+	}
+	passed = passed && parser.isValid() && parser.finish() == whole;
+
+	size_t offset = 0;
+	const BigNumber chunked = DigitParser::readChunks([&](char* buffer, size_t capacity)
+	{
+		const size_t count = std::min<size_t>({ capacity, 5, text.size() - offset });
+		std::memcpy(buffer, text.data() + offset, count);
+		offset += count;
+		return count;
+	});
+	passed = passed && chunked == whole;
+
+	// Several numbers from one stream
+	std::istringstream in("  12.5\n-0.0000001 INFINITY\t007 abc");
+	BigNumber a, b, c, d, e;
+	in >> a >> b >> c >> d;
+	passed = passed && a == BigNumber("12.5") && b == BigNumber(0) && static_cast<std::string>(c) == "INFINITY" && d == BigNumber(7) && !in.fail();
+	in >> e;
+	passed = passed && in.fail() && e.empty();
+
+	for (const char* bad : { "-", ".", "1.2.3", "12x", "NANX" })
+	{
+		std::istringstream badIn(bad);
+		passed = passed && !(badIn >> e) && e.empty();
+	}
+
+	m_stats["DigitParse "].first++;
+	if (passed)
+	{
+		m_stats["DigitParse "].second++;
+		printf("%40s      : PASS\n\n\n", testName.c_str());
+	}
+	else
+	{
+		printf("%40s      : FAIL\n\n\n", testName.c_str());
+	}
+}
+
+void Tester::charConvTest()
+{
+	cout << "Chars Conversion Test\n";
+
+	using Options = BigNumber::FormatOptions;
+	using Notation = Options::Notation;
+	using Sign = Options::Sign;
+	const auto makeOptions = [](const Notation notation, const Sign sign, const size_t precision, const char separator)
+	{
+		Options options;
+		options.notation = notation;
+		options.sign = sign;
+		options.precision = precision;
+		options.groupSeparator = separator;
+		return options;
+	};
+
+	// to_chars, the length written has to match size_hint
+	std::vector<std::string> num1;
+	std::vector<Options> format;
+	std::vector<std::string> res;
+
+	num1.emplace_back("-1234567.891");
+	format.emplace_back(Options());
+	res.emplace_back("-1234567.891");
+
+	num1.emplace_back("NAN");
+	format.emplace_back(Options());
+	res.emplace_back("NAN");
+
+	num1.emplace_back("-1234567.891");
+	format.emplace_back(makeOptions(Notation::kFIXED, Sign::kNEGATIVE, 2, ','));
+	res.emplace_back("-1,234,567.89");
+
+	num1.emplace_back("0.125");
+	format.emplace_back(makeOptions(Notation::kFIXED, Sign::kNEGATIVE, 2, ','));
+	res.emplace_back("0.12");
+
+	num1.emplace_back("999.996");
+	format.emplace_back(makeOptions(Notation::kFIXED, Sign::kALWAYS, 2, ','));
+	res.emplace_back("+1,000.00");
+
+	num1.emplace_back("-0.001");
+	format.emplace_back(makeOptions(Notation::kFIXED, Sign::kALWAYS, 2, ','));
+	res.emplace_back("+0.00");
+
+	num1.emplace_back("-1234567.891");
+	format.emplace_back(makeOptions(Notation::kSCIENTIFIC, Sign::kSPACE, 3, ','));
+	res.emplace_back("-1.235e+06");
+
+	num1.emplace_back("0.00099996");
+	format.emplace_back(makeOptions(Notation::kSCIENTIFIC, Sign::kSPACE, 3, ','));
+	res.emplace_back(" 1.000e-03");
+
+	num1.emplace_back("1200");
+	format.emplace_back(makeOptions(Notation::kSCIENTIFIC, Sign::kSPACE, Options::kEXACT, ','));
+	res.emplace_back(" 1.2e+03");
+
+	num1.emplace_back("0");
+	format.emplace_back(makeOptions(Notation::kSCIENTIFIC, Sign::kSPACE, Options::kEXACT, ','));
+	res.emplace_back(" 0e+00");
+
+	// from_chars, longest match rounded to the precision of the value: the value, the error and the text left
+	std::vector<std::string> text;
+	std::vector<char> separator;
+	std::vector<size_t> prec;
+	std::vector<std::string> parsed;
+
+	text.emplace_back("-1,234.56789e-2;");
+	separator.emplace_back(',');
+	prec.emplace_back(6);
+	parsed.emplace_back("-12.345679 ok ;");
+
+	text.emplace_back("6789e-2;");
+	separator.emplace_back('\0');
+	prec.emplace_back(1);
+	parsed.emplace_back("67.9 ok ;");
+
+	text.emplace_back(";");
+	separator.emplace_back('\0');
+	prec.emplace_back(1);
+	parsed.emplace_back("5 invalid ;");
+
+	int pass = 0;
+	std::string str;
+	for (size_t i = 0; i < num1.size(); ++i)
+	{
+		printf("Test                : %zu\n", i + 1);
+		printf("Number1  [%8zu] : %s\n", num1[i].size(), num1[i].c_str());
+		const BigNumber value(num1[i]);
+		char buffer[128];
+		const std::to_chars_result result = to_chars(buffer, buffer + sizeof(buffer), value, format[i]);
+		str.assign(buffer, result.ptr);
+		if (result.ec != std::errc() || str.size() != size_hint(value, format[i]))
+		{
+			str = "ERROR";
+		}
+		printf("Expected [%8zu] : %s\n", res[i].size(), res[i].c_str());
+		printf("Got      [%8zu] : %s\n\n", str.size(), str.c_str());
+		if (str == res[i])
+		{
+			pass++;
+			printf("CharConv Test %2zu    : PASS\n\n\n", i + 1);
+		}
+		else
+		{
+			printf("CharConv Test %2zu    : FAIL\n\n\n", i + 1);
+		}
+	}
+	for (size_t i = 0; i < text.size(); ++i)
+	{
+		const size_t test = num1.size() + i + 1;
+		printf("Test                : %zu\n", test);
+		printf("Text     [%8zu] : %s\n", text[i].size(), text[i].c_str());
+		BigNumber value(5);
+		value.setMaxPrecision(prec[i]);
+		Options options;
+		options.groupSeparator = separator[i];
+		const char* end = text[i].data() + text[i].size();
+		const std::from_chars_result result = from_chars(text[i].data(), end, value, options);
+		str = static_cast<std::string>(value) + (result.ec == std::errc() ? " ok " : " invalid ") + std::string(result.ptr, end);
+		printf("Expected [%8zu] : %s\n", parsed[i].size(), parsed[i].c_str());
+		printf("Got      [%8zu] : %s\n\n", str.size(), str.c_str());
+		if (str == parsed[i])
+		{
+			pass++;
+			printf("CharConv Test %2zu    : PASS\n\n\n", test);
+		}
+		else
+		{
+			printf("CharConv Test %2zu    : FAIL\n\n\n", test);
+		}
+	}
+
+	// Too small a buffer, and formatted text read back as the same value
+	const size_t test = num1.size() + text.size() + 1;
+	bool passed = true;
+	char small[4];
+	passed = passed && to_chars(small, small + sizeof(small), BigNumber("-1234567.891")).ec == std::errc::value_too_large;
+	BigNumber big = pow(BigNumber("-7.25"), BigNumber(90));
+	big.setMaxPrecision(200);
+	std::string out(size_hint(big), '\0');
+	to_chars(&out[0], &out[0] + out.size(), big);
+	BigNumber back;
+	back.setMaxPrecision(200);
+	passed = passed && from_chars(out.data(), out.data() + out.size(), back).ptr == out.data() + out.size() && back == big;
+	if (passed)
+	{
+		pass++;
+		printf("CharConv Test %2zu    : PASS\n\n\n", test);
+	}
+	else
+	{
+		printf("CharConv Test %2zu    : FAIL\n\n\n", test);
+	}
+	m_stats["CharConv   "] = std::make_pair(static_cast<int>(test), pass);
+}
+
 void Tester::preIncrementPositiveTest()
 {
 	std::string testName = "PreIncrement Positive value Test\n";
@@ -1159,5 +2312,50 @@ void Tester::postDecrementNegativeTest()
 		printf("%40s      : FAIL\n\n\n", testName.c_str());
 	}
 }
+
+void Tester::nativeOperandTest()
+{
+	std::string testName = "Native Operand Test\n";
+	cout << testName;
+	bool passed = true;
+	int64_t sum = 0;
+	BigNumber bigSum(sum);
+	for (int64_t i = m_I_MIN; i < m_I_MAX; ++i)
+	{
+		sum += i * i;
+		bigSum += i * i;
+		if (bigSum != sum || !(bigSum <= sum) || bigSum < sum)
+		{
+			passed = false;
+			break;
+		}
+	}
+
+	BigNumber num(1);
+	for (uint64_t i = 1; i <= 30; ++i)
+	{
+		num *= i;
+	}
+	passed = passed && static_cast<std::string>(num) == "265252859812191058636308480000000";
+	for (uint64_t i = 30; i > 1; --i)
+	{
+		num /= i;
+	}
+	passed = passed && num == 1;
+	passed = passed && static_cast<std::string>(BigNumber("12.5") * 0.5) == "6.25";
+	passed = passed && static_cast<std::string>(BigNumber("-7") % 3) == "1";
+	passed = passed && static_cast<std::string>(BigNumber("7") - 10u) == "-3";
+
+	m_stats["Native     "].first++;
+	if (passed)
+	{
+		m_stats["Native     "].second++;
+		printf("%40s      : PASS\n\n\n", testName.c_str());
+	}
+	else
+	{
+		printf("%40s      : FAIL\n\n\n", testName.c_str());
+	}
+}
 }
 #endif //#ifndef __VERIFICATION_TEST_H__
\ No newline at end of file